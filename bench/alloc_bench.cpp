@@ -0,0 +1,144 @@
+/**
+ * @file alloc_bench.cpp
+ * @brief Counts the heap traffic of solving, parsing and writing one puzzle.
+ *
+ * Every operation runs `--repeat` times on each standard puzzle (see
+ * standard_corpus.h) and the allocations, deallocations and bytes counted by
+ * alloc_stats.h are reported per operation. The counts do not depend on
+ * timing, so they can be compared exactly between commits while allocations
+ * are removed from the solver and I/O paths.
+ *
+ * Requires a build configured with `-DSUDOKU_ENABLE_ALLOC_STATS=ON`.
+ */
+
+#include "bench_common.h"
+#include "standard_corpus.h"
+#include "../include/alloc_stats.h"
+#include "../include/generator.h"
+#include "../include/puzzle_parser.h"
+#include "../include/sudoku.h"
+#include "../include/sudoku_io.h"
+#include "../include/utils.h"
+#include <algorithm>
+#include <filesystem>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+using namespace std;
+
+namespace {
+
+struct AllocOperation {
+    const char* group; // "solve", "parse" or "write"
+    const char* name;
+    bool easy_only; // Plain backtracking is impractical on the hard puzzles
+    function<void(const char* puzzle)> run;
+};
+
+void loadPuzzle(const char* line, int** BOARD) {
+    unsigned char cells[PUZZLE_LINE_LENGTH];
+    parsePuzzleLine(line, cells);
+    cellsToBoard(cells, BOARD);
+}
+
+} // namespace
+
+int runAllocBench(int argc, char** argv) {
+    if (!allocationTrackingEnabled()) {
+        cerr << "Allocation counting is disabled; reconfigure with -DSUDOKU_ENABLE_ALLOC_STATS=ON" << endl;
+        return 1;
+    }
+    const long long repeat = max(1LL, getIntOption(argc, argv, "repeat", 10));
+
+    vector<const char*> puzzles(STANDARD_EASY_PUZZLES, STANDARD_EASY_PUZZLES + STANDARD_EASY_COUNT);
+    puzzles.insert(puzzles.end(), STANDARD_HARD_PUZZLES, STANDARD_HARD_PUZZLES + STANDARD_HARD_COUNT);
+
+    const filesystem::path workspace = filesystem::temp_directory_path() / "sudoku_alloc_bench";
+    filesystem::remove_all(workspace);
+    filesystem::create_directories(workspace);
+    const string board_file = (workspace / "board.txt").string();
+
+    int** board = getEmptyBoard();
+    int** solved = getEmptyBoard();
+    string board_text;
+
+    // Prepares `solved` and `board_text` (untimed, uncounted) for the parse and write operations
+    auto prepare = [&](const char* puzzle) {
+        loadPuzzle(puzzle, solved);
+        solve(solved, true);
+        board_text.clear();
+        boardToString(solved, board_text);
+        streambuf* previous = cout.rdbuf(nullptr); // writeSudokuToFile reports on cout
+        writeSudokuToFile(solved, board_file);
+        cout.rdbuf(previous);
+    };
+
+    const vector<AllocOperation> operations = {
+        {"solve", "solve (backtracking)", true, [&](const char*) { doNotOptimize(solve(board)); }},
+        {"solve", "solve (mrv-backtracking)", false, [&](const char*) { doNotOptimize(solve(board, true)); }},
+        {"solve", "solve (propagation)", false, [&](const char*) { doNotOptimize(solve(board, SOLVE_PROPAGATION)); }},
+        {"solve", "solve (compact-mrv)", false, [&](const char*) { doNotOptimize(solve(board, SOLVE_COMPACT)); }},
+        {"solve", "checkIfSolutionIsValid", false, [&](const char*) { doNotOptimize(checkIfSolutionIsValid(solved)); }},
+        {"parse", "readSudokuFromString", false, [&](const char*) {
+             int** parsed = readSudokuFromString(board_text);
+             deallocateBoard(parsed);
+         }},
+        {"parse", "readSudokuFromFile", false, [&](const char*) {
+             int** parsed = readSudokuFromFile(board_file);
+             deallocateBoard(parsed);
+         }},
+        {"parse", "extractNumbers", false, [&](const char*) {
+             vector<int> numbers;
+             extractNumbers(board_text, numbers);
+             doNotOptimize(numbers);
+         }},
+        {"parse", "parsePuzzleLine", false, [&](const char* puzzle) {
+             unsigned char cells[PUZZLE_LINE_LENGTH];
+             doNotOptimize(parsePuzzleLine(puzzle, cells));
+         }},
+        {"write", "boardToString", false, [&](const char*) {
+             string content;
+             boardToString(solved, content);
+             doNotOptimize(content);
+         }},
+        {"write", "getFileName", false, [&](const char*) { doNotOptimize(getFileName(42, workspace.string(), "SOLUTION")); }},
+        {"write", "writeSudokuToFile", false, [&](const char*) {
+             streambuf* previous = cout.rdbuf(nullptr);
+             doNotOptimize(writeSudokuToFile(solved, board_file));
+             cout.rdbuf(previous);
+         }},
+    };
+
+    cout << left << setw(8) << "stage" << setw(28) << "operation" << right << setw(14) << "allocs/op" << setw(14)
+         << "frees/op" << setw(14) << "bytes/op" << endl;
+    for (const AllocOperation& operation : operations) {
+        AllocationCounters total;
+        long long calls = 0;
+        for (size_t p = 0; p < puzzles.size(); p++) {
+            if (operation.easy_only && p >= static_cast<size_t>(STANDARD_EASY_COUNT)) continue;
+            const char* puzzle = puzzles[p];
+            prepare(puzzle);
+            for (long long r = 0; r < repeat; r++) {
+                loadPuzzle(puzzle, board); // The solvers need the unsolved puzzle, the other operations ignore it
+                const AllocationCounters before = threadAllocationCounters();
+                operation.run(puzzle);
+                const AllocationCounters used = threadAllocationCounters() - before;
+                total.allocations += used.allocations;
+                total.deallocations += used.deallocations;
+                total.bytes += used.bytes;
+                calls++;
+            }
+        }
+        cout << left << setw(8) << operation.group << setw(28) << operation.name << right << fixed << setprecision(2)
+             << setw(14) << static_cast<double>(total.allocations) / calls << setw(14)
+             << static_cast<double>(total.deallocations) / calls << setw(14) << setprecision(1)
+             << static_cast<double>(total.bytes) / calls << endl;
+    }
+
+    deallocateBoard(board);
+    deallocateBoard(solved);
+    filesystem::remove_all(workspace);
+    return 0;
+}
@@ -0,0 +1,145 @@
+/**
+ * @file bench_common.h
+ * @brief Shared helpers for the SudokuBench benchmark executable.
+ *
+ * This header declares the entry point of every benchmark mode together with
+ * small helpers used by all of them:
+ * - Compiler barriers that keep benchmarked results from being optimized away.
+ * - A monotonic timer.
+ * - Minimal `--name value` / `--name=value` command line option parsing.
+ */
+
+#ifndef SUDOKUPROJECT_BENCH_COMMON_H
+#define SUDOKUPROJECT_BENCH_COMMON_H
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+using namespace std;
+
+// ============================ Benchmark modes ============================
+
+/**
+ * @brief Measures one-line puzzle parsing throughput (GB/s), vectorized vs scalar.
+ */
+int runParserBench(int argc, char** argv);
+
+/**
+ * @brief Solves the puzzles of a quarantine file again with every solver strategy.
+ */
+int runReplayBench(int argc, char** argv);
+
+/**
+ * @brief Measures every primitive of sudoku.h, sudoku_io.h, generator.h and utils.h in ns/op and allocations/op.
+ */
+int runMicroBench(int argc, char** argv);
+
+/**
+ * @brief Runs the standard benchmarks, writes them as JSON and fails on a significant regression
+ *        against the stored baseline.
+ */
+int runCompareBench(int argc, char** argv);
+
+/**
+ * @brief Verifies the embedded reference corpora and benchmarks every solver strategy on each category.
+ */
+int runCorpusBench(int argc, char** argv);
+
+/**
+ * @brief Solves one corpus with 1, 2, 4 ... N threads and reports throughput, speedup, efficiency and idle time.
+ */
+int runScalingBench(int argc, char** argv);
+
+/**
+ * @brief Runs a generate-and-solve loop for a fixed duration per strategy and reports sustained
+ *        puzzles/second and its time series.
+ */
+int runThroughputBench(int argc, char** argv);
+
+/**
+ * @brief Compares cache misses of int** boards and CompactSudokuState under many interleaved solves.
+ */
+int runCacheBench(int argc, char** argv);
+
+/**
+ * @brief Reports heap allocations and bytes per solve, per parse and per write
+ *        (requires a `SUDOKU_ENABLE_ALLOC_STATS` build).
+ */
+int runAllocBench(int argc, char** argv);
+
+/**
+ * @brief Reports the generation rate and clue counts of minimal puzzles for each clue symmetry,
+ *        optionally verifying minimality.
+ */
+int runMinimalBench(int argc, char** argv);
+
+/**
+ * @brief Compares generateBoard() request latency without and with a GridPool of ready grids.
+ */
+int runPoolBench(int argc, char** argv);
+
+/**
+ * @brief Compares grid statistics of each full-grid sampler with importance-sampled uniform averages.
+ */
+int runGridBench(int argc, char** argv);
+
+// ================================ Helpers ================================
+
+/**
+ * @brief Prevents the compiler from discarding the computation of `value`.
+ */
+template <class T>
+inline void doNotOptimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile const void* sink;
+    sink = &value;
+#endif
+}
+
+/**
+ * @brief Forces pending memory writes to be considered observable.
+ */
+inline void clobberMemory() {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : : "memory");
+#endif
+}
+
+/**
+ * @brief Returns the seconds elapsed since `start` on the monotonic clock.
+ */
+inline double secondsSince(const chrono::steady_clock::time_point& start) {
+    return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+/**
+ * @brief Returns the value of option `--name`, or `fallback` when absent.
+ *
+ * Accepts both `--name value` and `--name=value`. A flag given without a value
+ * yields "1".
+ */
+inline string getOption(int argc, char** argv, const string& name, const string& fallback) {
+    const string flag = "--" + name;
+    for (int i = 1; i < argc; i++) {
+        const string arg = argv[i];
+        if (arg == flag) {
+            if (i + 1 < argc && strncmp(argv[i + 1], "--", 2) != 0) return argv[i + 1];
+            return "1";
+        }
+        if (arg.compare(0, flag.size() + 1, flag + "=") == 0) return arg.substr(flag.size() + 1);
+    }
+    return fallback;
+}
+
+/**
+ * @brief Integer variant of getOption().
+ */
+inline long long getIntOption(int argc, char** argv, const string& name, const long long& fallback) {
+    const string value = getOption(argc, argv, name, "");
+    return value.empty() ? fallback : atoll(value.c_str());
+}
+
+#endif //SUDOKUPROJECT_BENCH_COMMON_H
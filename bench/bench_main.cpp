@@ -0,0 +1,49 @@
+/**
+ * @file bench_main.cpp
+ * @brief Entry point of the SudokuBench executable.
+ *
+ * Usage: `SudokuBench <mode> [options]`. Each mode is a separate benchmark
+ * declared in bench_common.h; running without a mode lists them.
+ */
+
+#include "bench_common.h"
+#include <iostream>
+
+using namespace std;
+
+struct BenchMode {
+    const char* name;
+    const char* description;
+    int (*run)(int argc, char** argv);
+};
+
+static const BenchMode MODES[] = {
+    {"parse", "One-line puzzle parser throughput (--lines N, --repeat R, --file PATH)", runParserBench},
+    {"replay", "Re-solve a quarantine corpus with every strategy (--file PATH, --repeat R)", runReplayBench},
+    {"micro", "Solver primitive microbenchmarks in ns/op and allocs/op (--filter NAME, --min-time S, --samples N)", runMicroBench},
+    {"compare", "Regression gate against bench/baseline.json (--trials N, --alpha P, --threshold PCT, --update)", runCompareBench},
+    {"corpus", "Every strategy on each reference corpus (--category NAME, --strategy NAME, --repeat R, --node-limit N)", runCorpusBench},
+    {"scaling", "Thread-count scaling of corpus solving (--max-threads N, --chunk K, --pin, --category NAME, --strategy NAME, --repeat R)", runScalingBench},
+    {"throughput", "Sustained generate-and-solve rate over time (--duration S, --warmup S, --interval S, --empty-boxes N, --strategy NAME)", runThroughputBench},
+    {"cache", "Cache misses of int** vs compact solver state (--states LIST, --threads T, --core C, --solves N)", runCacheBench},
+    {"alloc", "Heap allocations and bytes per solve, parse and write; needs SUDOKU_ENABLE_ALLOC_STATS (--repeat R)", runAllocBench},
+    {"minimal", "Minimal puzzle generation rate, clue counts and rejected removals per symmetry and removal order (--count N, --empty N, --symmetry NAME, --order NAME, --seed S, --verify)", runMinimalBench},
+    {"pool", "generateBoard latency without and with a background-refilled grid pool (--requests N, --depth D, --workers W, --interval-us U, --empty-boxes N)", runPoolBench},
+    {"grids", "Distance of each full-grid sampler from uniform on symmetry-invariant statistics, fails if the uniform one is biased (--samples N, --reference N, --cap LOGW, --max-z Z)", runGridBench},
+};
+
+int main(int argc, char** argv) {
+    if (argc >= 2) {
+        for (const BenchMode& mode : MODES) {
+            if (string(argv[1]) == mode.name) return mode.run(argc - 1, argv + 1);
+        }
+        cerr << "Unknown benchmark mode: " << argv[1] << endl;
+    }
+
+    cout << "Usage: " << argv[0] << " <mode> [options]" << endl;
+    cout << "Modes:" << endl;
+    for (const BenchMode& mode : MODES) {
+        cout << "  " << mode.name << "\t" << mode.description << endl;
+    }
+    return argc >= 2 ? 1 : 0;
+}
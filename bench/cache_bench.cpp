@@ -0,0 +1,251 @@
+/**
+ * @file cache_bench.cpp
+ * @brief Cache behaviour of the `int**` board against CompactSudokuState under many interleaved solves.
+ *
+ * Each worker owns `--states` independent solver states and solves them in
+ * round-robin order (a fixed easy puzzle is loaded into the state before each
+ * solve), which is what many concurrent solves sharing one core look like to
+ * the caches: by the time a state comes around again, the others have evicted
+ * it. With `--threads` above 1, all workers are pinned to the same `--core`
+ * and time-share it.
+ *
+ * Three variants are measured:
+ * - `int** mrv`: solve(SOLVE_MRV) on a heap board (ten scattered cache lines).
+ * - `int** -> compact`: solveBoardCompact() on a heap board, i.e. the compact
+ *   search plus the conversion from and to the `int**` board.
+ * - `compact`: solveCompact() on a CompactSudokuState (three contiguous lines).
+ *
+ * L1 data and last-level cache misses are read with perf_event_open (Linux,
+ * needs perf_event_paranoid <= 2 or CAP_PERFMON); where the counters are not
+ * available only time and nodes are reported. Misses per 1000 search nodes
+ * separate the effect of the layout from that of the algorithm.
+ */
+
+#include "bench_common.h"
+#include "standard_corpus.h"
+#include "../include/compact_state.h"
+#include "../include/generator.h"
+#include "../include/puzzle_parser.h"
+#include "../include/sudoku.h"
+#include "../include/utils.h"
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <thread>
+#include <vector>
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+namespace {
+
+enum CacheVariant { VARIANT_INT_BOARD_MRV = 0, VARIANT_INT_BOARD_COMPACT, VARIANT_COMPACT };
+const char* const VARIANT_NAMES[] = {"int** mrv", "int** -> compact", "compact"};
+const int VARIANT_COUNT = 3;
+
+// Hardware cache-miss counters of the calling thread; inactive where perf_event_open is unavailable
+class CacheCounters {
+public:
+    CacheCounters() {
+#ifdef __linux__
+        l1_fd = open(PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                                             (PERF_COUNT_HW_CACHE_RESULT_MISS << 16));
+        llc_fd = open(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES);
+#endif
+    }
+
+    ~CacheCounters() {
+#ifdef __linux__
+        if (l1_fd >= 0) close(l1_fd);
+        if (llc_fd >= 0) close(llc_fd);
+#endif
+    }
+
+    bool available() const {
+        return l1_fd >= 0 && llc_fd >= 0;
+    }
+
+    void start() {
+#ifdef __linux__
+        for (int fd : {l1_fd, llc_fd}) {
+            if (fd < 0) continue;
+            ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+            ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+        }
+#endif
+    }
+
+    // Stops counting and returns {L1D read misses, last-level cache misses}
+    pair<long long, long long> stop() {
+        return {read(l1_fd), read(llc_fd)};
+    }
+
+private:
+#ifdef __linux__
+    static int open(const unsigned int& type, const unsigned long long& config) {
+        perf_event_attr attr = {};
+        attr.size = sizeof(attr);
+        attr.type = type;
+        attr.config = config;
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+    }
+#endif
+
+    static long long read(const int& fd) {
+#ifdef __linux__
+        if (fd < 0) return 0;
+        ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+        long long value = 0;
+        if (::read(fd, &value, sizeof(value)) != sizeof(value)) return 0;
+        return value;
+#else
+        (void)fd;
+        return 0;
+#endif
+    }
+
+    int l1_fd = -1;
+    int llc_fd = -1;
+};
+
+struct CacheResult {
+    chrono::steady_clock::time_point start, end; // Measured interval (earliest start to latest end once merged)
+    long long solves = 0;
+    long long nodes = 0;
+    long long l1_misses = 0;
+    long long llc_misses = 0;
+    bool counted = true;   // Every worker could read the counters
+    long long failed = 0;
+};
+
+void pinToCore(const int& core) {
+#ifdef __linux__
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(core % CPU_SETSIZE, &set);
+    pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#else
+    (void)core;
+#endif
+}
+
+// One worker: `states` states of the variant, solved round-robin until `solves` solves are done
+void runWorker(const CacheVariant& variant, const vector<unsigned char>& puzzles, const int& states, const long long& solves,
+               const int& core, const bool& pin, CacheResult& result) {
+    if (pin) pinToCore(core);
+    const int puzzle_count = static_cast<int>(puzzles.size() / PUZZLE_LINE_LENGTH);
+    vector<int**> boards;
+    vector<CompactSudokuState> compact;
+    if (variant == VARIANT_COMPACT) compact.resize(states);
+    else for (int i = 0; i < states; i++) boards.push_back(getEmptyBoard());
+
+    CacheCounters counters;
+    const long long nodes_before = getSolveNodeCount();
+    counters.start();
+    result.start = chrono::steady_clock::now();
+    for (long long n = 0; n < solves; n++) {
+        const int i = static_cast<int>(n % states);
+        const unsigned char* cells = &puzzles[(n % puzzle_count) * PUZZLE_LINE_LENGTH];
+        bool solved;
+        if (variant == VARIANT_COMPACT) {
+            solved = loadCompactState(cells, compact[i]) && solveCompact(compact[i]);
+        } else {
+            cellsToBoard(cells, boards[i]);
+            solved = variant == VARIANT_INT_BOARD_MRV ? solve(boards[i], SOLVE_MRV) : solveBoardCompact(boards[i]);
+        }
+        if (!solved) result.failed++;
+    }
+    result.end = chrono::steady_clock::now();
+    const pair<long long, long long> misses = counters.stop();
+    result.nodes = getSolveNodeCount() - nodes_before;
+    result.solves = solves;
+    result.l1_misses = misses.first;
+    result.llc_misses = misses.second;
+    result.counted = counters.available();
+    for (int** board : boards) deallocateBoard(board);
+}
+
+vector<int> parseStateCounts(const string& list) {
+    vector<int> counts;
+    stringstream items(list);
+    string item;
+    while (getline(items, item, ',')) {
+        const int count = atoi(item.c_str());
+        if (count > 0) counts.push_back(count);
+    }
+    return counts;
+}
+
+} // namespace
+
+int runCacheBench(int argc, char** argv) {
+    const vector<int> state_counts = parseStateCounts(getOption(argc, argv, "states", "1,64,1024,16384"));
+    const int threads = static_cast<int>(max(1LL, getIntOption(argc, argv, "threads", 1)));
+    const long long solves = max(1LL, getIntOption(argc, argv, "solves", 20000));
+    const int core = static_cast<int>(getIntOption(argc, argv, "core", 0));
+    const bool pin = threads > 1 || getOption(argc, argv, "pin", "0") != "0";
+
+    vector<unsigned char> puzzles(STANDARD_EASY_COUNT * PUZZLE_LINE_LENGTH);
+    for (int p = 0; p < STANDARD_EASY_COUNT; p++) parsePuzzleLine(STANDARD_EASY_PUZZLES[p], &puzzles[p * PUZZLE_LINE_LENGTH]);
+
+    cout << threads << " worker(s)" << (pin ? " pinned to core " + to_string(core) : "") << ", " << solves
+         << " solves per worker, sizeof(CompactSudokuState) = " << sizeof(CompactSudokuState) << endl;
+    cout << left << setw(18) << "variant" << right << setw(8) << "states" << setw(12) << "ns/solve" << setw(14)
+         << "nodes/solve" << setw(14) << "L1D miss/slv" << setw(14) << "LLC miss/slv" << setw(16) << "L1D miss/1k nd"
+         << endl;
+
+    int failures = 0;
+    bool counters_missing = false;
+    for (const int states : state_counts) {
+        for (int v = 0; v < VARIANT_COUNT; v++) {
+            vector<CacheResult> results(threads);
+            vector<thread> workers;
+            for (int t = 0; t < threads; t++) {
+                workers.emplace_back(runWorker, static_cast<CacheVariant>(v), cref(puzzles), states, solves, core, pin,
+                                     ref(results[t]));
+            }
+            for (thread& worker : workers) worker.join();
+
+            CacheResult total;
+            total.start = results[0].start;
+            total.end = results[0].end;
+            for (const CacheResult& result : results) {
+                total.start = min(total.start, result.start);
+                total.end = max(total.end, result.end);
+                total.solves += result.solves;
+                total.nodes += result.nodes;
+                total.l1_misses += result.l1_misses;
+                total.llc_misses += result.llc_misses;
+                total.counted = total.counted && result.counted;
+                total.failed += result.failed;
+            }
+            failures += static_cast<int>(total.failed);
+            const double per_solve = 1.0 / total.solves;
+            const double seconds = chrono::duration<double>(total.end - total.start).count();
+            cout << left << setw(18) << VARIANT_NAMES[v] << right << setw(8) << states << fixed << setprecision(1)
+                 << setw(12) << seconds * 1e9 * per_solve << setw(14) << total.nodes * per_solve;
+            if (total.counted) {
+                cout << setprecision(2) << setw(14) << total.l1_misses * per_solve << setw(14)
+                     << total.llc_misses * per_solve << setw(16) << 1000.0 * total.l1_misses / max(1LL, total.nodes);
+            } else {
+                counters_missing = true;
+                cout << setw(14) << "n/a" << setw(14) << "n/a" << setw(16) << "n/a";
+            }
+            cout << endl;
+        }
+    }
+    if (counters_missing) cout << "Cache counters unavailable (perf_event_open refused or unsupported)" << endl;
+    if (failures > 0) cerr << failures << " solves failed" << endl;
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,411 @@
+/**
+ * @file compare_bench.cpp
+ * @brief Performance regression gate: runs the standard benchmarks and compares
+ *        them with a stored baseline.
+ *
+ * Each benchmark is measured in `--trials` independent trials (ns per puzzle
+ * or per operation). Results are written as JSON and compared benchmark by
+ * benchmark with the baseline file using a one-sided Mann-Whitney U test:
+ * a benchmark regresses when its trials are significantly slower (p below
+ * `--alpha`) and its median slowed down by more than `--threshold` percent.
+ * The mode exits with status 1 if any benchmark regressed.
+ *
+ * Baselines are machine specific; refresh the committed one with `--update`
+ * after an intended performance change or on a new machine. The JSON also
+ * records the parser backend, the build type and the compiler; the gate
+ * refuses to compare runs where any of them differs, since a Debug build or
+ * another compiler shifts every timing.
+ */
+
+#include "bench_common.h"
+#include "standard_corpus.h"
+#include "../include/generator.h"
+#include "../include/puzzle_parser.h"
+#include "../include/sudoku.h"
+#include "../include/sudoku_io.h"
+#include "../include/utils.h"
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+using namespace std;
+
+#ifndef SUDOKU_BENCH_DIR
+#define SUDOKU_BENCH_DIR "bench"
+#endif
+
+#ifndef SUDOKU_BUILD_TYPE
+#define SUDOKU_BUILD_TYPE ""
+#endif
+
+namespace {
+
+struct BenchSeries {
+    string name;
+    string unit;
+    vector<double> samples;
+};
+
+// What the timings depend on besides the code; runs are only compared when all fields match
+struct BenchBuild {
+    string parser_backend;
+    string build_type;
+    string compiler;
+};
+
+BenchBuild currentBuild() {
+    BenchBuild build{puzzleParserBackend(), SUDOKU_BUILD_TYPE, "unknown"};
+    if (build.build_type.empty()) build.build_type = "none";
+#if defined(__clang__)
+    build.compiler =
+        "clang " + to_string(__clang_major__) + "." + to_string(__clang_minor__) + "." + to_string(__clang_patchlevel__);
+#elif defined(__GNUC__)
+    build.compiler = "gcc " + to_string(__GNUC__) + "." + to_string(__GNUC_MINOR__) + "." + to_string(__GNUC_PATCHLEVEL__);
+#elif defined(_MSC_VER)
+    build.compiler = "msvc " + to_string(_MSC_VER);
+#endif
+    return build;
+}
+
+// ------------------------------ Measurements ------------------------------
+
+// Runs `pass` (which performs `ops` operations) until `min_time` elapsed and returns ns per operation
+double measureTrial(const function<void()>& pass, const int& ops, const double& min_time) {
+    long long passes = 0;
+    double elapsed = 0;
+    auto start = chrono::steady_clock::now();
+    do {
+        pass();
+        passes++;
+        elapsed = secondsSince(start);
+    } while (elapsed < min_time);
+    return elapsed * 1e9 / (static_cast<double>(passes) * ops);
+}
+
+void loadPuzzle(const char* line, int** BOARD) {
+    unsigned char cells[PUZZLE_LINE_LENGTH];
+    parsePuzzleLine(line, cells);
+    cellsToBoard(cells, BOARD);
+}
+
+vector<BenchSeries> runStandardBenchmarks(const int& trials, const double& min_time) {
+    int** board = getEmptyBoard();
+    int** solved = getEmptyBoard();
+    loadPuzzle(STANDARD_EASY_PUZZLES[0], solved);
+    solve(solved);
+    string board_text;
+    boardToString(solved, board_text);
+    string lines;
+    for (const char* puzzle : STANDARD_EASY_PUZZLES) lines += string(puzzle) + "\n";
+    for (const char* puzzle : STANDARD_HARD_PUZZLES) lines += string(puzzle) + "\n";
+    const int line_count = STANDARD_EASY_COUNT + STANDARD_HARD_COUNT;
+
+    struct Benchmark {
+        const char* name;
+        int ops;
+        function<void()> pass;
+    };
+    const vector<Benchmark> benchmarks = {
+        {"solve.backtracking.easy", STANDARD_EASY_COUNT, [&]() {
+             for (const char* puzzle : STANDARD_EASY_PUZZLES) {
+                 loadPuzzle(puzzle, board);
+                 doNotOptimize(solve(board));
+             }
+         }},
+        {"solve.mrv.easy", STANDARD_EASY_COUNT, [&]() {
+             for (const char* puzzle : STANDARD_EASY_PUZZLES) {
+                 loadPuzzle(puzzle, board);
+                 doNotOptimize(solve(board, true));
+             }
+         }},
+        {"solve.mrv.hard", STANDARD_HARD_COUNT, [&]() {
+             for (const char* puzzle : STANDARD_HARD_PUZZLES) {
+                 loadPuzzle(puzzle, board);
+                 doNotOptimize(solve(board, true));
+             }
+         }},
+        {"parse.puzzleLines", line_count, [&]() {
+             vector<unsigned char> cells;
+             doNotOptimize(parsePuzzleLines(lines.data(), lines.size(), cells));
+         }},
+        {"io.readSudokuFromString", 1, [&]() {
+             int** parsed = readSudokuFromString(board_text);
+             doNotOptimize(parsed);
+             deallocateBoard(parsed);
+         }},
+        {"io.boardToString", 1, [&]() {
+             string content;
+             boardToString(solved, content);
+             doNotOptimize(content);
+         }},
+        {"validate.checkIfSolutionIsValid", 1, [&]() { doNotOptimize(checkIfSolutionIsValid(solved)); }},
+    };
+
+    vector<BenchSeries> results;
+    for (const Benchmark& benchmark : benchmarks) {
+        BenchSeries series{benchmark.name, "ns/op", {}};
+        measureTrial(benchmark.pass, benchmark.ops, min_time / 4); // Warm up caches and branch predictors
+        for (int t = 0; t < trials; t++) series.samples.push_back(measureTrial(benchmark.pass, benchmark.ops, min_time));
+        results.push_back(series);
+        cout << "." << flush;
+    }
+    cout << endl;
+    deallocateBoard(board);
+    deallocateBoard(solved);
+    return results;
+}
+
+// --------------------------------- JSON ---------------------------------
+
+bool writeResultsJson(const string& filename, const BenchBuild& build, const vector<BenchSeries>& results) {
+    ofstream out(filename, ios::trunc);
+    if (!out.is_open()) return false;
+    out << "{\n  \"version\": 1,\n  \"parser_backend\": \"" << build.parser_backend << "\",\n  \"build_type\": \""
+        << build.build_type << "\",\n  \"compiler\": \"" << build.compiler << "\",\n  \"benchmarks\": [\n";
+    out << setprecision(6);
+    for (size_t i = 0; i < results.size(); i++) {
+        out << "    {\"name\": \"" << results[i].name << "\", \"unit\": \"" << results[i].unit << "\", \"samples\": [";
+        for (size_t s = 0; s < results[i].samples.size(); s++) out << (s ? ", " : "") << results[i].samples[s];
+        out << "]}" << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    out << "  ]\n}\n";
+    return static_cast<bool>(out);
+}
+
+// Minimal reader for the files written by writeResultsJson(): objects, arrays, strings and numbers
+class JsonReader {
+public:
+    explicit JsonReader(const string& text) : text(text) {}
+
+    bool readResults(BenchBuild& build, vector<BenchSeries>& results) {
+        return parseObject([&](const string& key) {
+            if (key == "parser_backend") return parseString(build.parser_backend);
+            if (key == "build_type") return parseString(build.build_type);
+            if (key == "compiler") return parseString(build.compiler);
+            if (key != "benchmarks") return skipValue();
+            return parseArray([&]() {
+                BenchSeries series;
+                bool ok = parseObject([&](const string& field) {
+                    if (field == "name") return parseString(series.name);
+                    if (field == "unit") return parseString(series.unit);
+                    if (field == "samples") {
+                        return parseArray([&]() {
+                            double value;
+                            if (!parseNumber(value)) return false;
+                            series.samples.push_back(value);
+                            return true;
+                        });
+                    }
+                    return skipValue();
+                });
+                if (ok) results.push_back(series);
+                return ok;
+            });
+        });
+    }
+
+private:
+    void skipSpace() {
+        while (pos < text.size() && isspace(static_cast<unsigned char>(text[pos]))) pos++;
+    }
+
+    bool consume(const char& expected) {
+        skipSpace();
+        if (pos >= text.size() || text[pos] != expected) return false;
+        pos++;
+        return true;
+    }
+
+    bool parseString(string& value) {
+        if (!consume('"')) return false;
+        value.clear();
+        while (pos < text.size() && text[pos] != '"') {
+            if (text[pos] == '\\' && pos + 1 < text.size()) pos++;
+            value += text[pos++];
+        }
+        return consume('"');
+    }
+
+    bool parseNumber(double& value) {
+        skipSpace();
+        const char* begin = text.c_str() + pos;
+        char* end = nullptr;
+        value = strtod(begin, &end);
+        if (end == begin) return false;
+        pos += end - begin;
+        return true;
+    }
+
+    bool parseObject(const function<bool(const string&)>& onField) {
+        if (!consume('{')) return false;
+        if (consume('}')) return true;
+        do {
+            string key;
+            if (!parseString(key) || !consume(':') || !onField(key)) return false;
+        } while (consume(','));
+        return consume('}');
+    }
+
+    bool parseArray(const function<bool()>& onElement) {
+        if (!consume('[')) return false;
+        if (consume(']')) return true;
+        do {
+            if (!onElement()) return false;
+        } while (consume(','));
+        return consume(']');
+    }
+
+    bool skipValue() {
+        skipSpace();
+        if (pos >= text.size()) return false;
+        if (text[pos] == '{') return parseObject([&](const string&) { return skipValue(); });
+        if (text[pos] == '[') return parseArray([&]() { return skipValue(); });
+        if (text[pos] == '"') {
+            string ignored;
+            return parseString(ignored);
+        }
+        double number;
+        if (parseNumber(number)) return true;
+        while (pos < text.size() && isalpha(static_cast<unsigned char>(text[pos]))) pos++; // true, false, null
+        return true;
+    }
+
+    const string& text;
+    size_t pos = 0;
+};
+
+bool readResultsJson(const string& filename, BenchBuild& build, vector<BenchSeries>& results) {
+    ifstream in(filename);
+    if (!in.is_open()) return false;
+    const string text((istreambuf_iterator<char>(in)), istreambuf_iterator<char>());
+    return JsonReader(text).readResults(build, results);
+}
+
+// ------------------------------- Statistics -------------------------------
+
+double median(vector<double> values) {
+    sort(values.begin(), values.end());
+    const size_t n = values.size();
+    if (n == 0) return 0;
+    return n % 2 ? values[n / 2] : (values[n / 2 - 1] + values[n / 2]) / 2;
+}
+
+// One-sided Mann-Whitney U test: p-value of "current tends to be larger than baseline"
+// (normal approximation with tie and continuity corrections)
+double mannWhitneyGreater(const vector<double>& current, const vector<double>& baseline) {
+    const double n1 = current.size(), n2 = baseline.size();
+    if (n1 == 0 || n2 == 0) return 1.0;
+
+    vector<pair<double, int>> pooled;
+    for (double value : current) pooled.push_back({value, 0});
+    for (double value : baseline) pooled.push_back({value, 1});
+    sort(pooled.begin(), pooled.end());
+
+    double rank_sum = 0, tie_term = 0;
+    for (size_t i = 0; i < pooled.size();) {
+        size_t j = i;
+        while (j < pooled.size() && pooled[j].first == pooled[i].first) j++;
+        const double average_rank = (i + 1 + j) / 2.0;
+        for (size_t k = i; k < j; k++) {
+            if (pooled[k].second == 0) rank_sum += average_rank;
+        }
+        const double ties = static_cast<double>(j - i);
+        tie_term += ties * ties * ties - ties;
+        i = j;
+    }
+
+    const double n = n1 + n2;
+    const double u = rank_sum - n1 * (n1 + 1) / 2;
+    const double mean = n1 * n2 / 2;
+    const double variance = n1 * n2 / 12 * ((n + 1) - tie_term / (n * (n - 1)));
+    if (variance <= 0) return u > mean ? 0.0 : 1.0;
+    const double z = (u - mean - 0.5) / sqrt(variance);
+    return 0.5 * erfc(z / sqrt(2.0));
+}
+
+} // namespace
+
+int runCompareBench(int argc, char** argv) {
+    const string baseline_path = getOption(argc, argv, "baseline", string(SUDOKU_BENCH_DIR) + "/baseline.json");
+    const string out_path = getOption(argc, argv, "out", "bench_results.json");
+    const int trials = static_cast<int>(max(3LL, getIntOption(argc, argv, "trials", 12)));
+    const double min_time = atof(getOption(argc, argv, "min-time", "0.1").c_str());
+    const double alpha = atof(getOption(argc, argv, "alpha", "0.01").c_str());
+    const double threshold = atof(getOption(argc, argv, "threshold", "5").c_str());
+    const bool update = getOption(argc, argv, "update", "") == "1";
+
+    const BenchBuild build = currentBuild();
+    if (build.build_type != "Release") {
+        cerr << "Warning: " << build.build_type << " build, timings are not representative of a Release build" << endl;
+    }
+    cout << "Running standard benchmarks (" << trials << " trials)" << flush;
+    const vector<BenchSeries> current = runStandardBenchmarks(trials, min_time);
+    if (!writeResultsJson(out_path, build, current)) {
+        cerr << "Unable to write results: " << out_path << endl;
+        return 1;
+    }
+    cout << "Results written to " << out_path << endl;
+
+    if (update) {
+        if (!writeResultsJson(baseline_path, build, current)) {
+            cerr << "Unable to write baseline: " << baseline_path << endl;
+            return 1;
+        }
+        cout << "Baseline updated: " << baseline_path << endl;
+        return 0;
+    }
+
+    BenchBuild baseline_build;
+    vector<BenchSeries> baseline;
+    if (!readResultsJson(baseline_path, baseline_build, baseline)) {
+        cerr << "Unable to read baseline: " << baseline_path << " (create it with --update)" << endl;
+        return 1;
+    }
+    if (baseline_build.parser_backend != build.parser_backend || baseline_build.build_type != build.build_type ||
+        baseline_build.compiler != build.compiler) {
+        cerr << "Baseline " << baseline_path << " comes from another build (" << baseline_build.build_type << ", "
+             << baseline_build.compiler << ", " << baseline_build.parser_backend << " parser) than this run ("
+             << build.build_type << ", " << build.compiler << ", " << build.parser_backend
+             << " parser); rebuild to match it or refresh it with --update" << endl;
+        return 1;
+    }
+
+    int regressions = 0;
+    cout << left << setw(34) << "benchmark" << right << setw(14) << "baseline" << setw(14) << "current" << setw(10)
+         << "change" << setw(10) << "p" << "  verdict" << endl;
+    for (const BenchSeries& series : current) {
+        auto match = find_if(baseline.begin(), baseline.end(), [&](const BenchSeries& b) { return b.name == series.name; });
+        if (match == baseline.end()) {
+            cout << left << setw(34) << series.name << right << setw(14) << "-" << "  (not in baseline)" << endl;
+            continue;
+        }
+        const double before = median(match->samples), after = median(series.samples);
+        const double change = before > 0 ? (after - before) / before * 100 : 0;
+        const double p_slower = mannWhitneyGreater(series.samples, match->samples);
+        const double p_faster = mannWhitneyGreater(match->samples, series.samples);
+
+        string verdict = "unchanged";
+        if (p_slower < alpha && change > threshold) {
+            verdict = "REGRESSION";
+            regressions++;
+        } else if (p_faster < alpha && -change > threshold) {
+            verdict = "improved";
+        }
+        cout << left << setw(34) << series.name << right << fixed << setprecision(1) << setw(14) << before << setw(14)
+             << after << setw(9) << showpos << change << "%" << noshowpos << setw(10) << setprecision(4)
+             << min(p_slower, p_faster) << "  " << verdict << endl;
+    }
+
+    if (regressions > 0) {
+        cerr << regressions << " benchmark(s) regressed against " << baseline_path << endl;
+        return 1;
+    }
+    cout << "No significant regression against " << baseline_path << endl;
+    return 0;
+}
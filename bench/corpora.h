@@ -0,0 +1,26 @@
+/**
+ * @file corpora.h
+ * @brief Reference puzzle corpora embedded into SudokuBench.
+ *
+ * The corpora are checked in as one-puzzle-per-line text files under
+ * bench/corpora/ and turned into string constants by CMake at configure time
+ * (see the generated bench_corpora.cpp), so the benchmarks need no data files
+ * at run time. Each file starts with `#` comment lines describing its
+ * content and provenance.
+ */
+
+#ifndef SUDOKUPROJECT_CORPORA_H
+#define SUDOKUPROJECT_CORPORA_H
+
+/**
+ * @brief One embedded corpus: its category name and the content of its data file.
+ */
+struct EmbeddedCorpus {
+    const char* name;  ///< Category, the data file name without extension (e.g. "seventeen_clue").
+    const char* data;  ///< File content: comment lines starting with '#', then one 81-character puzzle per line.
+};
+
+extern const EmbeddedCorpus EMBEDDED_CORPORA[];
+extern const int EMBEDDED_CORPUS_COUNT;
+
+#endif //SUDOKUPROJECT_CORPORA_H
@@ -0,0 +1,154 @@
+/**
+ * @file corpus_bench.cpp
+ * @brief Benchmarks every solver strategy on each embedded reference corpus.
+ *
+ * Each category (see corpora.h) is first verified: every puzzle must be
+ * well-formed and have exactly one solution. Then every puzzle is solved
+ * `--repeat` times with each strategy, and the latency distribution and the
+ * search nodes are reported per category and strategy. Solves are bounded by
+ * `--node-limit` search nodes (plain backtracking needs billions of nodes on
+ * some adversarial puzzles); solves that give up are counted separately and
+ * left out of the latency distribution and of the nodes per solved puzzle.
+ * A strategy that solves nothing in a category shows `-` in those columns.
+ */
+
+#include "bench_common.h"
+#include "corpora.h"
+#include "../include/generator.h"
+#include "../include/latency_histogram.h"
+#include "../include/puzzle_parser.h"
+#include "../include/sudoku.h"
+#include "../include/sudoku_io.h"
+#include "../include/sudoku_tables.h"
+#include "../include/utils.h"
+#include <algorithm>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+using namespace std;
+
+namespace {
+
+// Counts the solutions of a flat puzzle, stopping at `limit` (bitmask search, most constrained cell first)
+int countSolutions(unsigned char* cells, unsigned short* rows, unsigned short* cols, unsigned short* boxes, const int& limit) {
+    int best = -1, best_count = 10;
+    unsigned short best_free = 0;
+    for (int i = 0; i < 81; i++) {
+        if (cells[i] != 0) continue;
+        const unsigned short free = static_cast<unsigned short>(~(rows[i / 9] | cols[i % 9] | boxes[SUDOKU_TABLES.box_of[i]]) & 0x1FF);
+        int count = 0;
+        for (unsigned short bits = free; bits; bits &= bits - 1) count++;
+        if (count < best_count) {
+            best = i;
+            best_count = count;
+            best_free = free;
+            if (count <= 1) break;
+        }
+    }
+    if (best < 0) return 1;
+
+    int found = 0;
+    const int box = SUDOKU_TABLES.box_of[best];
+    for (int digit = 0; digit < 9 && found < limit; digit++) {
+        const unsigned short bit = static_cast<unsigned short>(1 << digit);
+        if (!(best_free & bit)) continue;
+        cells[best] = static_cast<unsigned char>(digit + 1);
+        rows[best / 9] |= bit;
+        cols[best % 9] |= bit;
+        boxes[box] |= bit;
+        found += countSolutions(cells, rows, cols, boxes, limit - found);
+        rows[best / 9] &= ~bit;
+        cols[best % 9] &= ~bit;
+        boxes[box] &= ~bit;
+    }
+    cells[best] = 0;
+    return found;
+}
+
+// Returns the number of solutions of `puzzle` (0, 1 or 2 meaning "several"); 0 also for contradicting clues
+int solutionCount(const unsigned char* puzzle) {
+    unsigned char cells[PUZZLE_LINE_LENGTH];
+    unsigned short rows[9] = {}, cols[9] = {}, boxes[9] = {};
+    memcpy(cells, puzzle, PUZZLE_LINE_LENGTH);
+    for (int i = 0; i < 81; i++) {
+        if (cells[i] == 0) continue;
+        const unsigned short bit = static_cast<unsigned short>(1 << (cells[i] - 1));
+        const int box = SUDOKU_TABLES.box_of[i];
+        if ((rows[i / 9] | cols[i % 9] | boxes[box]) & bit) return 0;
+        rows[i / 9] |= bit;
+        cols[i % 9] |= bit;
+        boxes[box] |= bit;
+    }
+    return countSolutions(cells, rows, cols, boxes, 2);
+}
+
+} // namespace
+
+int runCorpusBench(int argc, char** argv) {
+    const string category = getOption(argc, argv, "category", "");
+    const string strategy = getOption(argc, argv, "strategy", "");
+    const long long repeat = max(1LL, getIntOption(argc, argv, "repeat", 1));
+    const long long node_limit = getIntOption(argc, argv, "node-limit", 20000000);
+    int failures = 0;
+    int** board = getEmptyBoard();
+
+    cout << left << setw(16) << "category" << setw(18) << "strategy" << right << setw(8) << "puzzles" << setw(12) << "mean ms"
+         << setw(12) << "p50 ms" << setw(12) << "p99 ms" << setw(12) << "max ms" << setw(14) << "nodes/solved" << setw(10)
+         << "gave up" << endl;
+    setSolveNodeLimit(node_limit);
+
+    for (int c = 0; c < EMBEDDED_CORPUS_COUNT; c++) {
+        const EmbeddedCorpus& corpus = EMBEDDED_CORPORA[c];
+        if (!category.empty() && category != corpus.name) continue;
+
+        size_t invalid = 0;
+        vector<unsigned char> cells;
+        const size_t count = parsePuzzleLines(corpus.data, strlen(corpus.data), cells, &invalid);
+        size_t not_unique = 0;
+        for (size_t p = 0; p < count; p++) {
+            if (solutionCount(&cells[p * PUZZLE_LINE_LENGTH]) != 1) not_unique++;
+        }
+        if (invalid > 0 || not_unique > 0) {
+            cerr << corpus.name << ": " << invalid << " malformed and " << not_unique << " non-unique puzzles" << endl;
+            failures++;
+            continue;
+        }
+
+        for (int s = 0; s < SOLVER_STRATEGY_COUNT; s++) {
+            const SolverStrategy solver = static_cast<SolverStrategy>(s);
+            if (!strategy.empty() && strategy != solverStrategyName(solver)) continue;
+            LatencyHistogram latency;
+            long long nodes = 0, gave_up = 0; // Nodes of the solved puzzles only
+            for (size_t p = 0; p < count; p++) {
+                for (long long r = 0; r < repeat; r++) {
+                    cellsToBoard(&cells[p * PUZZLE_LINE_LENGTH], board);
+                    const long long nodes_before = getSolveNodeCount();
+                    auto start = chrono::steady_clock::now();
+                    const bool solved = solve(board, solver) && checkIfSolutionIsValid(board);
+                    const double seconds = secondsSince(start);
+                    if (solved) {
+                        latency.recordSeconds(seconds);
+                        nodes += getSolveNodeCount() - nodes_before;
+                    } else if (solveHitNodeLimit()) gave_up++;
+                    else failures++;
+                }
+            }
+            cout << left << setw(16) << corpus.name << setw(18) << solverStrategyName(solver) << right << setw(8) << count;
+            if (latency.count() == 0) {
+                // Every solve gave up: zeros would read as the fastest row of the table
+                cout << setw(12) << "-" << setw(12) << "-" << setw(12) << "-" << setw(12) << "-" << setw(14) << "-";
+            } else {
+                cout << fixed << setprecision(3) << setw(12) << latency.mean() / 1e6 << setw(12)
+                     << latency.valueAtPercentile(50) / 1e6 << setw(12) << latency.valueAtPercentile(99) / 1e6 << setw(12)
+                     << latency.max() / 1e6 << setw(14) << nodes / static_cast<long long>(latency.count());
+            }
+            cout << setw(10) << gave_up << endl;
+        }
+    }
+    setSolveNodeLimit(0);
+    deallocateBoard(board);
+    if (failures > 0) cerr << failures << " corpus checks or solves failed" << endl;
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,316 @@
+/**
+ * @file micro_bench.cpp
+ * @brief Microbenchmarks of the primitives declared in sudoku.h, sudoku_io.h,
+ *        generator.h and utils.h.
+ *
+ * Every primitive runs on fixed inputs (one fixed puzzle and its solution).
+ * Cheap primitives are timed over batches of calls, calibrated to last about
+ * `--min-time` seconds; primitives that modify their input (the solvers,
+ * deleteRandomItems, ...) get a fresh copy before each call, and only the call
+ * itself is timed. The median of `--samples` runs is reported in ns/op,
+ * together with heap allocations and bytes per operation when the build
+ * counts allocations (`SUDOKU_ENABLE_ALLOC_STATS`, see alloc_stats.h); other
+ * builds print "-" in those columns.
+ *
+ * The batch drivers (createAndSaveNPuzzles, solveAndSaveNPuzzles,
+ * compareSudokuSolvers) are pipelines rather than primitives and are covered
+ * by the other modes.
+ */
+
+#include "bench_common.h"
+#include "../include/alloc_stats.h"
+#include "../include/generator.h"
+#include "../include/sudoku.h"
+#include "../include/sudoku_io.h"
+#include "../include/utils.h"
+#include <algorithm>
+#include <filesystem>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <tuple>
+#include <vector>
+
+using namespace std;
+
+static const int FIXED_PUZZLE[9][9] = {
+    {0, 0, 4, 0, 5, 0, 0, 0, 0}, {9, 0, 0, 7, 3, 4, 6, 0, 0}, {0, 0, 3, 0, 2, 1, 0, 4, 9},
+    {0, 3, 5, 0, 9, 0, 4, 8, 0}, {0, 9, 0, 0, 0, 0, 0, 3, 0}, {0, 7, 6, 0, 1, 0, 9, 2, 0},
+    {3, 1, 0, 9, 7, 0, 2, 0, 0}, {0, 0, 9, 1, 8, 2, 0, 0, 3}, {0, 0, 0, 0, 6, 0, 1, 0, 0},
+};
+
+static const char* const EMPTY_PUZZLE = ".................................................................................";
+
+// A puzzle with few clues that makes plain backtracking work much harder
+static const char* const HARD_PUZZLE = "..............3.85..1.2.......5.7.....4...1...9.......5......73..2.1........4...9";
+
+namespace {
+
+struct MicroResult {
+    double ns_per_op;
+    double allocs_per_op;
+    double bytes_per_op;
+};
+
+// Discards everything written to it, used to silence printing primitives
+class NullBuffer : public streambuf {
+protected:
+    int overflow(int c) override { return c; }
+    streamsize xsputn(const char*, streamsize n) override { return n; }
+};
+
+class SilenceCout {
+public:
+    SilenceCout() : previous(cout.rdbuf(&sink)) {}
+    ~SilenceCout() { cout.rdbuf(previous); }
+
+private:
+    NullBuffer sink;
+    streambuf* previous;
+};
+
+class MicroSuite {
+public:
+    MicroSuite(const string& filter, const double& min_time, const int& samples)
+        : filter(filter), min_time(min_time), samples(max(1, samples)), out(cout.rdbuf()) {}
+
+    // Times `op` in calibrated batches of calls
+    void run(const string& name, const function<void()>& op) {
+        if (!selected(name)) return;
+        long long batch = 1;
+        for (;;) {
+            auto start = chrono::steady_clock::now();
+            for (long long i = 0; i < batch; i++) op();
+            const double elapsed = secondsSince(start);
+            if (elapsed >= min_time / samples || batch >= (1LL << 40)) break;
+            batch = elapsed <= 0 ? batch * 10 : max(batch * 2, static_cast<long long>(batch * (min_time / samples) / elapsed));
+        }
+
+        vector<MicroResult> results;
+        for (int s = 0; s < samples; s++) {
+            const AllocationCounters before = threadAllocationCounters();
+            auto start = chrono::steady_clock::now();
+            for (long long i = 0; i < batch; i++) op();
+            const double elapsed = secondsSince(start);
+            const AllocationCounters used = threadAllocationCounters() - before;
+            results.push_back({elapsed * 1e9 / batch, static_cast<double>(used.allocations) / batch,
+                               static_cast<double>(used.bytes) / batch});
+        }
+        report(name, results);
+    }
+
+    // Calls `setup` (untimed) before each timed call of `op`
+    void runWithSetup(const string& name, const function<void()>& setup, const function<void()>& op) {
+        if (!selected(name)) return;
+        vector<MicroResult> results;
+        for (int s = 0; s < samples; s++) {
+            double timed = 0;
+            unsigned long long allocs = 0, bytes = 0;
+            long long calls = 0;
+            auto sample_start = chrono::steady_clock::now();
+            do {
+                setup();
+                const AllocationCounters before = threadAllocationCounters();
+                auto start = chrono::steady_clock::now();
+                op();
+                timed += secondsSince(start);
+                const AllocationCounters used = threadAllocationCounters() - before;
+                allocs += used.allocations;
+                bytes += used.bytes;
+                calls++;
+            } while (secondsSince(sample_start) < min_time / samples);
+            results.push_back({timed * 1e9 / calls, static_cast<double>(allocs) / calls, static_cast<double>(bytes) / calls});
+        }
+        report(name, results);
+    }
+
+private:
+    bool selected(const string& name) const {
+        return filter.empty() || name.find(filter) != string::npos;
+    }
+
+    void report(const string& name, vector<MicroResult>& results) {
+        sort(results.begin(), results.end(), [](const MicroResult& a, const MicroResult& b) { return a.ns_per_op < b.ns_per_op; });
+        const MicroResult& median = results[results.size() / 2];
+        out << left << setw(40) << name << right << fixed << setprecision(1) << setw(14) << median.ns_per_op;
+        if (allocationTrackingEnabled()) {
+            out << setw(14) << setprecision(2) << median.allocs_per_op << setw(14) << setprecision(1) << median.bytes_per_op;
+        } else {
+            out << setw(14) << "-" << setw(14) << "-";
+        }
+        out << endl;
+    }
+
+    const string filter;
+    const double min_time;
+    const int samples;
+    ostream out; // Bound to the real standard output, so results survive SilenceCout
+};
+
+void copyFixed(const int source[9][9], int** BOARD) {
+    for (int r = 0; r < 9; r++) {
+        for (int c = 0; c < 9; c++) BOARD[r][c] = source[r][c];
+    }
+}
+
+void copyLine(const char* line, int** BOARD) {
+    for (int i = 0; i < 81; i++) BOARD[i / 9][i % 9] = line[i] == '.' ? 0 : line[i] - '0';
+}
+
+} // namespace
+
+int runMicroBench(int argc, char** argv) {
+    MicroSuite suite(getOption(argc, argv, "filter", ""), atof(getOption(argc, argv, "min-time", "0.2").c_str()),
+                     static_cast<int>(getIntOption(argc, argv, "samples", 5)));
+
+    int solution[9][9];
+    int** puzzle = getEmptyBoard();
+    int** solved = getEmptyBoard();
+    int** scratch = getEmptyBoard();
+    copyFixed(FIXED_PUZZLE, puzzle);
+    copyFixed(FIXED_PUZZLE, solved);
+    solve(solved);
+    for (int r = 0; r < 9; r++) {
+        for (int c = 0; c < 9; c++) solution[r][c] = solved[r][c];
+    }
+
+    string board_text;
+    boardToString(puzzle, board_text);
+    vector<int> numbers;
+    extractNumbers(board_text, numbers);
+
+    const filesystem::path workspace = filesystem::temp_directory_path() / "sudoku_micro_bench";
+    filesystem::remove_all(workspace);
+    filesystem::create_directories(workspace / "puzzles");
+    const string board_file = (workspace / "board.txt").string();
+    {
+        SilenceCout silence;
+        writeSudokuToFile(puzzle, board_file);
+        for (int i = 0; i < 32; i++) writeSudokuToFile(puzzle, getFileName(i, (workspace / "puzzles").string(), "PUZZLE"));
+    }
+
+    cout << left << setw(40) << "primitive" << right << setw(14) << "ns/op" << setw(14) << "allocs/op" << setw(14)
+         << "bytes/op" << endl;
+
+    // ------------------------------ sudoku.h ------------------------------
+    suite.run("isValid (valid digit)", [&]() { doNotOptimize(isValid(puzzle, 4, 4, 5)); });
+    suite.run("isValid (row conflict)", [&]() { doNotOptimize(isValid(puzzle, 0, 0, 4)); });
+    suite.run("findNextCell", [&]() { doNotOptimize(findNextCell(puzzle)); });
+    suite.runWithSetup("solveBoard", [&]() { copyFixed(FIXED_PUZZLE, scratch); }, [&]() { doNotOptimize(solveBoard(scratch)); });
+    suite.runWithSetup("solveBoardEfficient", [&]() { copyFixed(FIXED_PUZZLE, scratch); },
+                       [&]() { doNotOptimize(solveBoardEfficient(scratch)); });
+    suite.runWithSetup("solve (backtracking)", [&]() { copyFixed(FIXED_PUZZLE, scratch); }, [&]() { doNotOptimize(solve(scratch)); });
+    suite.runWithSetup("solve (mrv, hard puzzle)", [&]() { copyLine(HARD_PUZZLE, scratch); },
+                       [&]() { doNotOptimize(solve(scratch, true)); });
+    suite.runWithSetup("solveBoardPropagation", [&]() { copyFixed(FIXED_PUZZLE, scratch); },
+                       [&]() { doNotOptimize(solveBoardPropagation(scratch)); });
+    suite.runWithSetup("solve (propagation, hard puzzle)", [&]() { copyLine(HARD_PUZZLE, scratch); },
+                       [&]() { doNotOptimize(solve(scratch, SOLVE_PROPAGATION)); });
+    suite.runWithSetup("solveBoardCompact", [&]() { copyFixed(FIXED_PUZZLE, scratch); },
+                       [&]() { doNotOptimize(solveBoardCompact(scratch)); });
+    suite.runWithSetup("solve (compact-mrv, hard puzzle)", [&]() { copyLine(HARD_PUZZLE, scratch); },
+                       [&]() { doNotOptimize(solve(scratch, SOLVE_COMPACT)); });
+    suite.run("solverStrategyName", [&]() { doNotOptimize(solverStrategyName(true)); });
+    suite.run("getSolveNodeCount", [&]() { doNotOptimize(getSolveNodeCount()); });
+
+    // ----------------------------- sudoku_io.h -----------------------------
+    char render_buffer[BOARD_TEXT_BUFFER_SIZE];
+    suite.run("renderBoard", [&]() {
+        doNotOptimize(renderBoard(puzzle, render_buffer));
+        clobberMemory();
+    });
+    suite.run("renderBoard (color)", [&]() {
+        doNotOptimize(renderBoard(solved, render_buffer, 4, 4, 5, true));
+        clobberMemory();
+    });
+    {
+        SilenceCout silence;
+        suite.run("printBoard (to null stream)", [&]() { printBoard(puzzle); });
+    }
+    suite.run("boardToString", [&]() {
+        string content;
+        boardToString(puzzle, content);
+        doNotOptimize(content);
+    });
+    {
+        SilenceCout silence;
+        suite.run("writeSudokuToFile", [&]() { doNotOptimize(writeSudokuToFile(puzzle, board_file)); });
+    }
+    suite.run("replaceCharacter", [&]() {
+        string text = board_text;
+        replaceCharacter(text, '-', '0');
+        doNotOptimize(text);
+    });
+    suite.run("extractNumbers", [&]() {
+        vector<int> extracted;
+        extractNumbers(board_text, extracted);
+        doNotOptimize(extracted);
+    });
+    suite.run("fillBoard + deallocateBoard", [&]() {
+        int** board = new int*[9]; // fillBoard allocates the rows itself
+        fillBoard(numbers, board);
+        doNotOptimize(board);
+        deallocateBoard(board);
+    });
+    suite.run("readSudokuFromString", [&]() {
+        int** board = readSudokuFromString(board_text);
+        doNotOptimize(board);
+        deallocateBoard(board);
+    });
+    suite.run("readSudokuFromFile", [&]() {
+        int** board = readSudokuFromFile(board_file);
+        doNotOptimize(board);
+        deallocateBoard(board);
+    });
+    suite.run("checkIfSolutionIsValid", [&]() { doNotOptimize(checkIfSolutionIsValid(solved)); });
+    {
+        SilenceCout silence;
+        suite.run("getAllSudokuInFolder (32 files)", [&]() { doNotOptimize(getAllSudokuInFolder((workspace / "puzzles").string())); });
+    }
+    suite.run("deepCopyBoard", [&]() {
+        int** board = deepCopyBoard(puzzle);
+        doNotOptimize(board);
+        deallocateBoard(board);
+    });
+
+    // ----------------------------- generator.h -----------------------------
+    suite.run("getEmptyBoard + deallocateBoard", [&]() {
+        int** board = getEmptyBoard();
+        doNotOptimize(board);
+        deallocateBoard(board);
+    });
+    suite.run("getShuffledVector", [&]() { doNotOptimize(getShuffledVector()); });
+    suite.runWithSetup("fillBoardWithIndependentBox", [&]() { copyLine(EMPTY_PUZZLE, scratch); },
+                       [&]() { fillBoardWithIndependentBox(scratch); clobberMemory(); });
+    suite.runWithSetup("deleteRandomItems (45)", [&]() { copyFixed(solution, scratch); },
+                       [&]() { deleteRandomItems(scratch, 45); clobberMemory(); });
+    suite.run("generateBoard (45)", [&]() {
+        int** board = generateBoard(45);
+        doNotOptimize(board);
+        deallocateBoard(board);
+    });
+
+    // ------------------------------- utils.h -------------------------------
+    {
+        SilenceCout silence;
+        suite.run("createFolder (existing)", [&]() { createFolder(workspace.string()); });
+        const filesystem::path previous = filesystem::current_path();
+        filesystem::current_path(workspace);
+        suite.run("initDataFolder (existing)", [&]() { initDataFolder(); });
+        filesystem::current_path(previous);
+    }
+    suite.run("shardedFileNameLayout", [&]() { doNotOptimize(shardedFileNameLayout()); });
+    suite.run("setFileNameLayout + getFileNameLayout", [&]() {
+        setFileNameLayout(FileNameLayout());
+        doNotOptimize(getFileNameLayout());
+    });
+    const string nested_file = (workspace / "nested" / "a" / "b.txt").string();
+    suite.run("createParentFolders (cached)", [&]() { doNotOptimize(createParentFolders(nested_file)); });
+    suite.run("getFileName", [&]() { doNotOptimize(getFileName(1234, "data/puzzles/", "PUZZLE")); });
+
+    deallocateBoard(puzzle);
+    deallocateBoard(solved);
+    deallocateBoard(scratch);
+    filesystem::remove_all(workspace);
+    return 0;
+}
@@ -0,0 +1,148 @@
+/**
+ * @file minimal_bench.cpp
+ * @brief Generation rate and clue counts of minimal puzzles (generateMinimalBoard()) and unique ones
+ *        (generateUniqueBoard()).
+ *
+ * For each clue symmetry and removal order (or only `--symmetry NAME` and
+ * `--order NAME`), generates `--count` minimal puzzles on one thread, or with
+ * `--empty N` puzzles with N empty cells and a unique solution. It reports
+ * puzzles per second, time per puzzle, the clue counts, and the removal tests
+ * per puzzle that were rejected or needed a search (getRemovalCounters()).
+ * With a single symmetry selected it also prints the distribution of clue
+ * counts. With `--verify`, every puzzle is checked afterwards, outside the
+ * timed loop: it must have exactly one solution and a clue pattern invariant
+ * under the symmetry, and a minimal one must lose its unique solution when
+ * any single orbit of clues is removed. `--seed S` makes the run reproducible.
+ */
+
+#include "bench_common.h"
+#include "../include/clue_symmetry.h"
+#include "../include/compact_state.h"
+#include "../include/generator.h"
+#include "../include/sudoku.h"
+#include "../include/sudoku_tables.h"
+#include "../include/utils.h"
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+using namespace std;
+
+namespace {
+
+// Checks from scratch that `cells` has one solution, a symmetric pattern and, if `minimal`, that every orbit
+// of clues is needed
+bool isValidPuzzle(const unsigned char* cells, const ClueSymmetry& symmetry, const bool& minimal) {
+    CompactSudokuState state;
+    if (!loadCompactState(cells, state) || countCompactSolutions(state, 2) != 1) return false;
+    const ClueOrbits& orbits = CLUE_ORBITS[symmetry];
+    unsigned char reduced[SUDOKU_CELLS];
+    copy(cells, cells + SUDOKU_CELLS, reduced);
+    for (int orbit = 0; orbit < orbits.count; orbit++) {
+        const unsigned char* members = orbits.cells[orbit];
+        const int size = orbits.size[orbit];
+        const bool filled = cells[members[0]] != 0;
+        for (int i = 0; i < size; i++) {
+            if ((cells[members[i]] != 0) != filled) return false; // Asymmetric pattern
+            reduced[members[i]] = 0;
+        }
+        if (filled && minimal) {
+            loadCompactState(reduced, state);
+            if (countCompactSolutions(state, 2) != 2) return false;
+        }
+        for (int i = 0; i < size; i++) reduced[members[i]] = cells[members[i]];
+    }
+    return true;
+}
+
+} // namespace
+
+int runMinimalBench(int argc, char** argv) {
+    const long long count = max(1LL, getIntOption(argc, argv, "count", 1000));
+    const bool verify = getOption(argc, argv, "verify", "0") != "0";
+    const int target = static_cast<int>(min<long long>(SUDOKU_CELLS, getIntOption(argc, argv, "empty", SUDOKU_CELLS)));
+    const bool minimal = target >= SUDOKU_CELLS;
+    const string seed = getOption(argc, argv, "seed", "");
+    const string symmetry_name = getOption(argc, argv, "symmetry", "");
+    const string order_name = getOption(argc, argv, "order", "");
+    ClueSymmetry selected = SYMMETRY_NONE;
+    RemovalOrder selected_order = REMOVAL_RANDOM;
+    if (!symmetry_name.empty() && !clueSymmetryFromName(symmetry_name, selected)) {
+        cerr << "Unknown symmetry: " << symmetry_name << endl;
+        return 1;
+    }
+    if (!order_name.empty() && !removalOrderFromName(order_name, selected_order)) {
+        cerr << "Unknown removal order: " << order_name << endl;
+        return 1;
+    }
+
+    cout << count << (minimal ? " minimal puzzles" : " unique puzzles with up to " + to_string(target) + " empty cells")
+         << " per symmetry and removal order" << endl;
+    cout << left << setw(12) << "symmetry" << setw(21) << "order" << right << setw(11) << "puzzles/s" << setw(11)
+         << "us/puzzle" << setw(12) << "mean clues" << setw(6) << "min" << setw(6) << "max" << setw(14) << "rejected/pzl"
+         << setw(14) << "searches/pzl" << endl;
+
+    int failures = 0;
+    for (int run = 0; run < CLUE_SYMMETRY_COUNT * REMOVAL_ORDER_COUNT; run++) {
+        const ClueSymmetry symmetry = static_cast<ClueSymmetry>(run / REMOVAL_ORDER_COUNT);
+        const RemovalOrder order = static_cast<RemovalOrder>(run % REMOVAL_ORDER_COUNT);
+        if (!symmetry_name.empty() && symmetry != selected) continue;
+        if (!order_name.empty() && order != selected_order) continue;
+        if (!seed.empty()) setGeneratorSeed(static_cast<unsigned int>(atoll(seed.c_str())));
+
+        vector<unsigned char> puzzles(count * SUDOKU_CELLS);
+        const RemovalCounters before = getRemovalCounters();
+        auto start = chrono::steady_clock::now();
+        for (long long n = 0; n < count; n++) {
+            int** board = minimal ? generateMinimalBoard(symmetry, order) : generateUniqueBoard(target, symmetry, order);
+            for (int cell = 0; cell < SUDOKU_CELLS; cell++) {
+                puzzles[n * SUDOKU_CELLS + cell] =
+                    static_cast<unsigned char>(board[SUDOKU_TABLES.row_of[cell]][SUDOKU_TABLES.col_of[cell]]);
+            }
+            deallocateBoard(board);
+        }
+        const double seconds = secondsSince(start);
+        const RemovalCounters after = getRemovalCounters();
+
+        vector<long long> histogram(SUDOKU_CELLS + 1, 0);
+        long long total_clues = 0;
+        for (long long n = 0; n < count; n++) {
+            const unsigned char* cells = &puzzles[n * SUDOKU_CELLS];
+            const int clues = static_cast<int>(count_if(cells, cells + SUDOKU_CELLS, [](unsigned char k) { return k != 0; }));
+            histogram[clues]++;
+            total_clues += clues;
+        }
+        int fewest = 0, most = SUDOKU_CELLS;
+        while (histogram[fewest] == 0) fewest++;
+        while (histogram[most] == 0) most--;
+        cout << left << setw(12) << clueSymmetryName(symmetry) << setw(21) << removalOrderName(order) << right << fixed
+             << setprecision(1) << setw(11) << count / seconds << setw(11) << 1e6 * seconds / count << setprecision(2)
+             << setw(12) << static_cast<double>(total_clues) / count << setw(6) << fewest << setw(6) << most
+             << setprecision(1) << setw(14) << static_cast<double>(after.rejected - before.rejected) / count << setw(14) << static_cast<double>(after.searches - before.searches) / count << endl;
+
+        if (!symmetry_name.empty()) {
+            cout << right << setw(8) << "clues" << setw(10) << "puzzles" << setw(10) << "share" << endl;
+            for (int clues = fewest; clues <= most; clues++) {
+                if (histogram[clues] == 0) continue;
+                cout << setw(8) << clues << setw(10) << histogram[clues] << setprecision(1) << setw(9)
+                     << 100.0 * histogram[clues] / count << "%" << endl;
+            }
+        }
+
+        if (!verify) continue;
+        long long invalid = 0;
+        for (long long n = 0; n < count; n++) {
+            if (!isValidPuzzle(&puzzles[n * SUDOKU_CELLS], symmetry, minimal)) invalid++;
+        }
+        if (invalid > 0) {
+            cerr << clueSymmetryName(symmetry) << "/" << removalOrderName(order) << ": " << invalid << " of " << count
+                 << " puzzles lack a unique solution, a symmetric pattern or minimality" << endl;
+            failures++;
+        }
+    }
+    if (verify && failures == 0) {
+        cout << "Verified: unique solutions, symmetric patterns" << (minimal ? ", no removable orbit" : "") << endl;
+    }
+    return failures == 0 ? 0 : 1;
+}
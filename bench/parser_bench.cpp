@@ -0,0 +1,114 @@
+/**
+ * @file parser_bench.cpp
+ * @brief Throughput benchmark for the one-line puzzle parser.
+ *
+ * Builds (or loads) a corpus of puzzle lines in memory and reports the
+ * parsing throughput in GB/s of the vectorized parser, the scalar fallback
+ * and, for reference, the regex based parsing of the board text format used
+ * by readSudokuFromFile().
+ */
+
+#include "bench_common.h"
+#include "../include/puzzle_parser.h"
+#include "../include/sudoku_io.h"
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace std;
+
+static string makeCorpus(const long long& lines) {
+    mt19937 rng(2025);
+    uniform_int_distribution<int> digit(0, 9);
+    const char blanks[] = {'.', '0', '-'};
+    string corpus;
+    corpus.reserve(static_cast<size_t>(lines) * (PUZZLE_LINE_LENGTH + 1));
+    for (long long i = 0; i < lines; i++) {
+        for (int j = 0; j < PUZZLE_LINE_LENGTH; j++) {
+            int value = digit(rng);
+            corpus += value == 0 ? blanks[rng() % 3] : static_cast<char>('0' + value);
+        }
+        corpus += '\n';
+    }
+    return corpus;
+}
+
+static void report(const string& name, const double& bytes, const double& seconds, const size_t& puzzles) {
+    cout << left << setw(28) << name << right << fixed << setprecision(3)
+         << setw(10) << bytes / seconds / 1e9 << " GB/s"
+         << setw(14) << setprecision(1) << puzzles / seconds / 1e3 << " Kpuzzles/s" << endl;
+}
+
+int runParserBench(int argc, char** argv) {
+    const long long lines = getIntOption(argc, argv, "lines", 1000000);
+    const long long repeat = getIntOption(argc, argv, "repeat", 5);
+    const string file = getOption(argc, argv, "file", "");
+
+    string corpus;
+    if (!file.empty()) {
+        ifstream in(file, ios::binary);
+        if (!in.is_open()) {
+            cerr << "Unable to open file: " << file << endl;
+            return 1;
+        }
+        corpus.assign(istreambuf_iterator<char>(in), istreambuf_iterator<char>());
+    } else {
+        corpus = makeCorpus(lines);
+    }
+    const double bytes = static_cast<double>(corpus.size()) * repeat;
+
+    cout << "Corpus: " << corpus.size() << " bytes, parser backend: " << puzzleParserBackend() << endl;
+
+    // Vectorized bulk parser, best of `repeat` passes into a reused buffer
+    vector<unsigned char> cells;
+    cells.reserve(corpus.size());
+    size_t parsed = 0;
+    auto start = chrono::steady_clock::now();
+    for (long long i = 0; i < repeat; i++) {
+        cells.clear();
+        parsed = parsePuzzleLines(corpus.data(), corpus.size(), cells);
+        doNotOptimize(cells.data());
+    }
+    report(string("parsePuzzleLines (") + puzzleParserBackend() + ")", bytes, secondsSince(start), parsed * repeat);
+
+    // Scalar fallback over the same lines
+    vector<unsigned char> scalarCells(parsed * PUZZLE_LINE_LENGTH);
+    size_t valid = 0;
+    start = chrono::steady_clock::now();
+    for (long long i = 0; i < repeat; i++) {
+        valid = 0;
+        for (size_t line = 0; line < parsed; line++) {
+            valid += parsePuzzleLineScalar(corpus.data() + line * (PUZZLE_LINE_LENGTH + 1),
+                                           scalarCells.data() + line * PUZZLE_LINE_LENGTH);
+        }
+        doNotOptimize(scalarCells.data());
+    }
+    report("parsePuzzleLineScalar", bytes, secondsSince(start), valid * repeat);
+    if (file.empty() && scalarCells != cells) cerr << "!! Scalar and vectorized parsers disagree" << endl;
+
+    // Regex based parsing of the multi-line board text read by readSudokuFromFile, on a sample
+    const size_t sample = min<size_t>(parsed, 20000);
+    vector<string> texts(sample);
+    double textBytes = 0;
+    int rows[9][9];
+    int* board[9];
+    for (int r = 0; r < 9; r++) board[r] = rows[r];
+    for (size_t i = 0; i < sample; i++) {
+        cellsToBoard(cells.data() + i * PUZZLE_LINE_LENGTH, board);
+        boardToString(board, texts[i]);
+        textBytes += static_cast<double>(texts[i].size());
+    }
+    vector<int> numbers;
+    start = chrono::steady_clock::now();
+    for (size_t i = 0; i < sample; i++) {
+        string text = texts[i];
+        replaceCharacter(text, '-', '0');
+        numbers.clear();
+        extractNumbers(text, numbers);
+        doNotOptimize(numbers.data());
+    }
+    report("extractNumbers (board text)", textBytes, secondsSince(start), sample);
+    return 0;
+}
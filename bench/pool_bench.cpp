@@ -0,0 +1,76 @@
+/**
+ * @file pool_bench.cpp
+ * @brief Request latency of generateBoard() with and without a GridPool.
+ *
+ * Emulates an on-demand puzzle endpoint: `--requests` calls to
+ * generateBoard(`--empty-boxes`), one at a time with `--interval-us`
+ * microseconds of idle time between them (0: back to back). The same request
+ * stream runs first without a pool and then with a GridPool of `--depth` grids
+ * and `--workers` refill threads, filled before the first request. The mode
+ * reports the latency percentiles, the request rate and the pool hit rate. When
+ * the requests come faster than the workers refill, the pool drains and misses
+ * fall back to building the grid on the request path.
+ */
+
+#include "bench_common.h"
+#include "../include/generator.h"
+#include "../include/grid_pool.h"
+#include "../include/latency_histogram.h"
+#include "../include/utils.h"
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <thread>
+
+using namespace std;
+
+int runPoolBench(int argc, char** argv) {
+    const long long requests = max(1LL, getIntOption(argc, argv, "requests", 20000));
+    const int empty_boxes = static_cast<int>(getIntOption(argc, argv, "empty-boxes", 45));
+    const unsigned depth = static_cast<unsigned>(max(1LL, getIntOption(argc, argv, "depth", 256)));
+    const unsigned workers = static_cast<unsigned>(max(1LL, getIntOption(argc, argv, "workers", 1)));
+    const long long interval_us = max(0LL, getIntOption(argc, argv, "interval-us", 0));
+
+    cout << requests << " generateBoard(" << empty_boxes << ") requests, " << interval_us
+         << " us apart; pool depth " << depth << ", " << workers << " refill worker(s)" << endl;
+    cout << left << setw(10) << "config" << right << setw(12) << "mean us" << setw(10) << "p50 us" << setw(10)
+         << "p99 us" << setw(12) << "p99.9 us" << setw(12) << "max us" << setw(12) << "req/s" << setw(10) << "hits"
+         << endl;
+
+    for (int with_pool = 0; with_pool < 2; with_pool++) {
+        unique_ptr<GridPool> pool;
+        if (with_pool) {
+            pool.reset(new GridPool(depth, workers));
+            while (pool->size() < depth) this_thread::sleep_for(chrono::milliseconds(1));
+            setGridPool(pool.get());
+        }
+
+        LatencyHistogram latency;
+        auto start = chrono::steady_clock::now();
+        for (long long n = 0; n < requests; n++) {
+            auto request_start = chrono::steady_clock::now();
+            int** board = generateBoard(empty_boxes);
+            latency.recordSeconds(secondsSince(request_start));
+            doNotOptimize(board[0][0]);
+            deallocateBoard(board);
+            // Idle like a server waiting for the next request, leaving the core to the refill workers
+            if (interval_us > 0) this_thread::sleep_for(chrono::microseconds(interval_us));
+        }
+        const double seconds = secondsSince(start);
+
+        cout << left << setw(10) << (with_pool ? "pool" : "no pool") << right << fixed << setprecision(2) << setw(12)
+             << latency.mean() / 1e3 << setw(10) << latency.valueAtPercentile(50) / 1e3 << setw(10)
+             << latency.valueAtPercentile(99) / 1e3 << setw(12) << latency.valueAtPercentile(99.9) / 1e3 << setw(12)
+             << latency.max() / 1e3 << setprecision(0) << setw(12) << requests / seconds;
+        if (with_pool) {
+            setGridPool(nullptr);
+            const GridPoolStats stats = pool->stats();
+            cout << setprecision(1) << setw(9) << 100.0 * stats.hits / max(1LL, stats.hits + stats.misses) << "%";
+        } else {
+            cout << setw(10) << "-";
+        }
+        cout << endl;
+    }
+    return 0;
+}
@@ -0,0 +1,80 @@
+/**
+ * @file replay_bench.cpp
+ * @brief Replays the puzzles captured in a quarantine file.
+ *
+ * Every quarantined puzzle is solved again `--repeat` times with each solver
+ * strategy. The best time and the node count are printed next to the values
+ * recorded at capture time, followed by the latency distribution of each
+ * strategy over the whole corpus.
+ */
+
+#include "bench_common.h"
+#include "../include/generator.h"
+#include "../include/latency_histogram.h"
+#include "../include/puzzle_parser.h"
+#include "../include/quarantine.h"
+#include "../include/sudoku.h"
+#include "../include/sudoku_io.h"
+#include "../include/utils.h"
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+using namespace std;
+
+int runReplayBench(int argc, char** argv) {
+    const string file = getOption(argc, argv, "file", "data/quarantine.txt");
+    const long long repeat = max(1LL, getIntOption(argc, argv, "repeat", 3));
+
+    vector<QuarantineRecord> records;
+    if (!loadQuarantine(file, records)) {
+        cerr << "Unable to read quarantine file: " << file << endl;
+        return 1;
+    }
+    cout << "Replaying " << records.size() << " quarantined puzzles from " << file << " (best of " << repeat << ")" << endl;
+
+    LatencyHistogram latency[SOLVER_STRATEGY_COUNT];
+    int** board = getEmptyBoard();
+    unsigned char cells[PUZZLE_LINE_LENGTH];
+    int failures = 0;
+
+    cout << left << setw(6) << "#" << setw(18) << "strategy" << right << setw(14) << "recorded ms" << setw(14)
+         << "recorded nodes";
+    for (int s = 0; s < SOLVER_STRATEGY_COUNT; s++) {
+        cout << setw(20) << string(solverStrategyName(static_cast<SolverStrategy>(s))) + " ms" << setw(12) << "nodes";
+    }
+    cout << endl;
+
+    for (size_t i = 0; i < records.size(); i++) {
+        const QuarantineRecord& record = records[i];
+        parsePuzzleLine(record.puzzle.c_str(), cells);
+        cout << left << setw(6) << i << setw(18) << record.strategy << right << fixed << setprecision(3) << setw(14)
+             << record.seconds * 1e3 << setw(14) << record.nodes;
+
+        for (int s = 0; s < SOLVER_STRATEGY_COUNT; s++) {
+            double best = -1;
+            long long nodes = 0;
+            for (long long r = 0; r < repeat; r++) {
+                cellsToBoard(cells, board);
+                const long long nodes_before = getSolveNodeCount();
+                auto start = chrono::steady_clock::now();
+                const bool solved = solve(board, static_cast<SolverStrategy>(s)) && checkIfSolutionIsValid(board);
+                const double seconds = secondsSince(start);
+                nodes = getSolveNodeCount() - nodes_before;
+                if (!solved) failures++;
+                latency[s].recordSeconds(seconds);
+                if (best < 0 || seconds < best) best = seconds;
+            }
+            cout << setw(20) << best * 1e3 << setw(12) << nodes;
+        }
+        cout << endl;
+    }
+    deallocateBoard(board);
+
+    for (int s = 0; s < SOLVER_STRATEGY_COUNT; s++) {
+        cout << left << setw(18) << solverStrategyName(static_cast<SolverStrategy>(s)) << latency[s].summary() << endl;
+    }
+    if (failures > 0) cerr << failures << " replayed solves failed" << endl;
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,190 @@
+/**
+ * @file scaling_bench.cpp
+ * @brief Solves the same corpus with 1, 2, 4 ... N worker threads to show where throughput stops scaling.
+ *
+ * The workers share one queue: an atomic index into the puzzle list, from
+ * which each worker claims `--chunk` puzzles at a time. For every thread count
+ * the mode reports throughput, speedup and efficiency against one thread,
+ * and the idle time of the workers (the part of the wall time they did not
+ * spend solving: start-up, claiming work and waiting for the slowest worker).
+ * Efficiency that drops while idle time stays low points at contention inside
+ * the solve (false sharing, memory bandwidth); high idle time points at the
+ * queue or at load imbalance, which a larger `--chunk` or more puzzles reduce.
+ * Every worker also records the latency of each solve into its own histogram
+ * of a LatencyHistogramGroup; the merged p50 and p99 show whether the solves
+ * themselves slow down as threads are added.
+ *
+ * With `--pin`, worker i is bound to CPU i (Linux only).
+ */
+
+#include "bench_common.h"
+#include "corpora.h"
+#include "../include/generator.h"
+#include "../include/latency_histogram.h"
+#include "../include/puzzle_parser.h"
+#include "../include/sudoku.h"
+#include "../include/sudoku_io.h"
+#include "../include/utils.h"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+#include <vector>
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+using namespace std;
+
+namespace {
+
+// Per-worker results, one cache line each so the workers never share a line while running
+struct alignas(64) WorkerResult {
+    double busy_seconds = 0;
+    long long solved = 0;
+    long long gave_up = 0;
+    long long failed = 0;
+};
+
+struct ScalingRun {
+    double wall_seconds;
+    long long solved;
+    long long gave_up;
+    long long failed;
+    double mean_idle;  // Mean fraction of the wall time a worker was idle
+    double max_idle;   // Largest such fraction over the workers
+    double p50_us;     // Median solve latency over every worker
+    double p99_us;
+};
+
+bool pinToCpu(thread& worker, const int& cpu) {
+#ifdef __linux__
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu % CPU_SETSIZE, &set);
+    return pthread_setaffinity_np(worker.native_handle(), sizeof(set), &set) == 0;
+#else
+    (void)worker;
+    (void)cpu;
+    return false;
+#endif
+}
+
+ScalingRun runWorkers(const vector<unsigned char>& cells, const size_t& puzzles, const long long& repeat, const int& threads,
+                      const long long& chunk, const SolverStrategy& solver, const long long& node_limit, const bool& pin) {
+    const long long total = static_cast<long long>(puzzles) * repeat;
+    alignas(64) atomic<long long> next(0);
+    alignas(64) atomic<bool> go(false);
+    vector<WorkerResult> results(threads);
+    vector<thread> workers;
+    LatencyHistogramGroup latencies;
+
+    for (int t = 0; t < threads; t++) {
+        workers.emplace_back([&, t]() {
+            WorkerResult result;
+            LatencyHistogram& latency = latencies.local();
+            int** board = getEmptyBoard();
+            setSolveNodeLimit(node_limit);
+            while (!go.load(memory_order_acquire)) this_thread::yield();
+            for (;;) {
+                const long long begin = next.fetch_add(chunk, memory_order_relaxed);
+                if (begin >= total) break;
+                const long long end = min(total, begin + chunk);
+                auto start = chrono::steady_clock::now();
+                for (long long i = begin; i < end; i++) {
+                    const auto solve_start = chrono::steady_clock::now();
+                    cellsToBoard(&cells[(i % puzzles) * PUZZLE_LINE_LENGTH], board);
+                    if (solve(board, solver) && checkIfSolutionIsValid(board)) result.solved++;
+                    else if (solveHitNodeLimit()) result.gave_up++;
+                    else result.failed++;
+                    latency.record(static_cast<unsigned long long>(
+                        chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - solve_start).count()));
+                }
+                result.busy_seconds += secondsSince(start);
+            }
+            deallocateBoard(board);
+            results[t] = result;
+        });
+        if (pin && !pinToCpu(workers.back(), t)) cerr << "Could not pin worker " << t << " to CPU " << t << endl;
+    }
+
+    auto start = chrono::steady_clock::now();
+    go.store(true, memory_order_release);
+    for (thread& worker : workers) worker.join();
+    const double wall = secondsSince(start);
+
+    const LatencyHistogram merged = latencies.merged();
+    ScalingRun run = {wall, 0, 0, 0, 0, 0, merged.valueAtPercentile(50) / 1000.0, merged.valueAtPercentile(99) / 1000.0};
+    for (const WorkerResult& result : results) {
+        run.solved += result.solved;
+        run.gave_up += result.gave_up;
+        run.failed += result.failed;
+        const double idle = wall > 0 ? max(0.0, 1.0 - result.busy_seconds / wall) : 0;
+        run.mean_idle += idle / threads;
+        run.max_idle = max(run.max_idle, idle);
+    }
+    return run;
+}
+
+} // namespace
+
+int runScalingBench(int argc, char** argv) {
+    const string category = getOption(argc, argv, "category", "");
+    SolverStrategy solver = SOLVE_MRV;
+    if (!solverStrategyFromName(getOption(argc, argv, "strategy", solverStrategyName(solver)), solver)) {
+        cerr << "Unknown solver strategy" << endl;
+        return 1;
+    }
+    const int hardware = max(1, static_cast<int>(thread::hardware_concurrency()));
+    const int max_threads = static_cast<int>(max(1LL, getIntOption(argc, argv, "max-threads", hardware)));
+    const long long repeat = max(1LL, getIntOption(argc, argv, "repeat", 1));
+    const long long chunk = max(1LL, getIntOption(argc, argv, "chunk", 1));
+    const long long node_limit = getIntOption(argc, argv, "node-limit", 20000000);
+    const bool pin = getOption(argc, argv, "pin", "0") != "0";
+
+    vector<unsigned char> cells;
+    size_t puzzles = 0;
+    for (int c = 0; c < EMBEDDED_CORPUS_COUNT; c++) {
+        const EmbeddedCorpus& corpus = EMBEDDED_CORPORA[c];
+        if (!category.empty() && category != corpus.name) continue;
+        vector<unsigned char> parsed;
+        puzzles += parsePuzzleLines(corpus.data, strlen(corpus.data), parsed);
+        cells.insert(cells.end(), parsed.begin(), parsed.end());
+    }
+    if (puzzles == 0) {
+        cerr << "No puzzles in category '" << category << "'" << endl;
+        return 1;
+    }
+
+    vector<int> counts;
+    for (int threads = 1; threads < max_threads; threads *= 2) counts.push_back(threads);
+    counts.push_back(max_threads);
+
+    cout << puzzles << " puzzles x " << repeat << " passes, " << solverStrategyName(solver) << ", chunk " << chunk
+         << ", " << hardware << " hardware threads" << (pin ? ", pinned" : "") << endl;
+    cout << right << setw(8) << "threads" << setw(14) << "puzzles/s" << setw(10) << "speedup" << setw(12) << "efficiency"
+         << setw(12) << "idle mean" << setw(12) << "idle max" << setw(10) << "p50 us" << setw(10) << "p99 us"
+         << setw(10) << "gave up" << endl;
+
+    int failures = 0;
+    double single_rate = 0;
+    for (const int threads : counts) {
+        const ScalingRun run = runWorkers(cells, puzzles, repeat, threads, chunk, solver, node_limit, pin);
+        const double rate = run.wall_seconds > 0 ? run.solved / run.wall_seconds : 0;
+        if (threads == 1) single_rate = rate;
+        const double speedup = single_rate > 0 ? rate / single_rate : 0;
+        cout << setw(8) << threads << fixed << setprecision(1) << setw(14) << rate << setprecision(2) << setw(10) << speedup
+             << setprecision(1) << setw(11) << 100 * speedup / threads << "%" << setw(11) << 100 * run.mean_idle << "%"
+             << setw(11) << 100 * run.max_idle << "%" << setw(10) << run.p50_us << setw(10) << run.p99_us << setw(10)
+             << run.gave_up << endl;
+        failures += static_cast<int>(run.failed);
+    }
+    if (max_threads > hardware) {
+        cout << "Note: more threads than hardware threads, speedup beyond " << hardware << " is not expected" << endl;
+    }
+    if (failures > 0) cerr << failures << " solves failed" << endl;
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,29 @@
+/**
+ * @file standard_corpus.h
+ * @brief Fixed puzzles shared by the SudokuBench modes that need stable inputs.
+ *
+ * Puzzles are 81-character lines with '.' or '0' for empty cells. The easy
+ * set is solved quickly by both solvers; the hard set is only practical for
+ * the MRV solver (tens of milliseconds each).
+ */
+
+#ifndef SUDOKUPROJECT_STANDARD_CORPUS_H
+#define SUDOKUPROJECT_STANDARD_CORPUS_H
+
+static const char* const STANDARD_EASY_PUZZLES[] = {
+    "..4.5....9..7346....3.21.49.35.9.48..9.....3..76.1.92.31.97.2....9182..3....6.1..",
+    "003020600900305001001806400008102900700000008006708200002609500800203009005010300",
+    "200080300060070084030500209000105408000000000402706000301007040720040060004010003",
+    "000000907000420180000705026100904000050000040000507009920108000034059000507000000",
+};
+
+static const char* const STANDARD_HARD_PUZZLES[] = {
+    "4.....8.5.3..........7......2.....6.....8.4......1.......6.3.7.5..2.....1.4......",
+    "52...6.........7.13...........4..8..6......5...........418.........3..2...87.....",
+    "6.....8.3.4.7.................5.4.7.3..2.....1.6.......2.....5.....8.6......1....",
+};
+
+static const int STANDARD_EASY_COUNT = sizeof(STANDARD_EASY_PUZZLES) / sizeof(STANDARD_EASY_PUZZLES[0]);
+static const int STANDARD_HARD_COUNT = sizeof(STANDARD_HARD_PUZZLES) / sizeof(STANDARD_HARD_PUZZLES[0]);
+
+#endif //SUDOKUPROJECT_STANDARD_CORPUS_H
@@ -0,0 +1,121 @@
+/**
+ * @file throughput_bench.cpp
+ * @brief Sustained generate-and-solve throughput over a fixed wall-clock duration.
+ *
+ * Unlike compareSudokuSolvers(), which runs a fixed number of puzzles, this
+ * mode generates and solves puzzles in a loop for `--duration` seconds per
+ * strategy, after a `--warmup` window that is not measured. It reports the
+ * sustained puzzles/second (generate + solve + validate) and the solve-only
+ * rate. It also prints a time series with one row per `--interval`: rate and
+ * resident memory. A falling rate over the series points at thermal
+ * throttling; a growing resident set points at leaks or heap fragmentation.
+ */
+
+#include "bench_common.h"
+#include "../include/generator.h"
+#include "../include/sudoku.h"
+#include "../include/sudoku_io.h"
+#include "../include/utils.h"
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+#ifdef __linux__
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+namespace {
+
+struct ThroughputSample {
+    double end_seconds;  // End of the interval, since the end of the warmup
+    double rate;         // Puzzles per second within the interval
+    double resident_mb;  // Resident set size at the end of the interval, negative if unknown
+};
+
+// Returns the resident set size of the process in MiB, or -1 where it cannot be read
+double residentMegabytes() {
+#ifdef __linux__
+    ifstream statm("/proc/self/statm");
+    long long pages = 0, resident = 0;
+    if (statm >> pages >> resident) return resident * static_cast<double>(sysconf(_SC_PAGESIZE)) / (1024.0 * 1024.0);
+#endif
+    return -1;
+}
+
+// Generates, solves and validates one puzzle; returns `true` if the solution is valid
+bool generateAndSolve(const int& empty_boxes, const SolverStrategy& solver, double& solve_seconds) {
+    int** board = generateBoard(empty_boxes);
+    auto start = chrono::steady_clock::now();
+    const bool solved = solve(board, solver) && checkIfSolutionIsValid(board);
+    solve_seconds += secondsSince(start);
+    deallocateBoard(board);
+    return solved;
+}
+
+} // namespace
+
+int runThroughputBench(int argc, char** argv) {
+    const double duration = max(0.1, atof(getOption(argc, argv, "duration", "10").c_str()));
+    const double warmup = max(0.0, atof(getOption(argc, argv, "warmup", "2").c_str()));
+    const double interval = max(0.05, atof(getOption(argc, argv, "interval", "1").c_str()));
+    const int empty_boxes = static_cast<int>(getIntOption(argc, argv, "empty-boxes", 45));
+    const string strategy = getOption(argc, argv, "strategy", "");
+    int failures = 0;
+
+    cout << "Generate-and-solve loop, " << empty_boxes << " empty cells, " << warmup << " s warmup, " << duration
+         << " s measured per strategy" << endl;
+
+    for (int s = 0; s < SOLVER_STRATEGY_COUNT; s++) {
+        const SolverStrategy solver = static_cast<SolverStrategy>(s);
+        if (!strategy.empty() && strategy != solverStrategyName(solver)) continue;
+
+        double ignored = 0;
+        auto warmup_start = chrono::steady_clock::now();
+        while (secondsSince(warmup_start) < warmup) generateAndSolve(empty_boxes, solver, ignored);
+
+        vector<ThroughputSample> series;
+        long long puzzles = 0, interval_puzzles = 0, invalid = 0;
+        double solve_seconds = 0, interval_start = 0, elapsed = 0;
+        auto start = chrono::steady_clock::now();
+        do {
+            if (!generateAndSolve(empty_boxes, solver, solve_seconds)) invalid++;
+            puzzles++;
+            interval_puzzles++;
+            elapsed = secondsSince(start);
+            if (elapsed - interval_start >= interval || elapsed >= duration) {
+                series.push_back({elapsed, interval_puzzles / (elapsed - interval_start), residentMegabytes()});
+                interval_start = elapsed;
+                interval_puzzles = 0;
+            }
+        } while (elapsed < duration);
+
+        cout << "---------------- " << solverStrategyName(solver) << " ----------------" << endl;
+        cout << right << setw(10) << "t (s)" << setw(14) << "puzzles/s" << setw(12) << "rss MiB" << endl;
+        double lowest = series.front().rate, highest = series.front().rate;
+        for (const ThroughputSample& sample : series) {
+            lowest = min(lowest, sample.rate);
+            highest = max(highest, sample.rate);
+            cout << fixed << setprecision(2) << setw(10) << sample.end_seconds << setprecision(1) << setw(14) << sample.rate;
+            if (sample.resident_mb >= 0) cout << setw(12) << sample.resident_mb << endl;
+            else cout << setw(12) << "n/a" << endl;
+        }
+        // The last interval is usually cut short by the deadline, so drift compares the first and last full ones
+        const size_t last = series.size() >= 3 ? series.size() - 2 : series.size() - 1;
+        const double drift = series.front().rate > 0 ? 100.0 * (series[last].rate / series.front().rate - 1.0) : 0;
+        cout << setprecision(1) << "Sustained: " << puzzles / elapsed << " puzzles/s | solve only: "
+             << (solve_seconds > 0 ? puzzles / solve_seconds : 0) << " puzzles/s | interval min " << lowest << " max "
+             << highest << " | drift " << showpos << drift << noshowpos << "%";
+        if (series.front().resident_mb >= 0) {
+            cout << " | rss growth " << series.back().resident_mb - series.front().resident_mb << " MiB";
+        }
+        cout << endl;
+        if (invalid > 0) {
+            cerr << solverStrategyName(solver) << ": " << invalid << " invalid solutions" << endl;
+            failures++;
+        }
+    }
+    return failures == 0 ? 0 : 1;
+}
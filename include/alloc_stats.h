@@ -0,0 +1,41 @@
+/**
+ * @file alloc_stats.h
+ * @brief Optional heap allocation accounting.
+ *
+ * When the project is configured with the CMake option `SUDOKU_ENABLE_ALLOC_STATS`,
+ * the global operator new/delete are replaced by versions that count, for
+ * each thread, the allocations, deallocations and bytes requested. Reading the
+ * counters before and after an operation gives its heap traffic, which
+ * batch statistics and SudokuBench report per solve, per parse and per write.
+ *
+ * Without the option nothing is replaced and the counters stay at zero.
+ */
+
+#ifndef SUDOKUPROJECT_ALLOC_STATS_H
+#define SUDOKUPROJECT_ALLOC_STATS_H
+
+/**
+ * @brief Heap counters of one thread.
+ */
+struct AllocationCounters {
+    unsigned long long allocations = 0;   ///< Calls to operator new / new[].
+    unsigned long long deallocations = 0; ///< Calls to operator delete / delete[] with a non-null pointer.
+    unsigned long long bytes = 0;         ///< Bytes requested from operator new / new[].
+};
+
+/**
+ * @brief Returns `true` if this build counts allocations (`SUDOKU_ENABLE_ALLOC_STATS`).
+ */
+bool allocationTrackingEnabled();
+
+/**
+ * @brief Returns the counters of the calling thread since it started.
+ */
+AllocationCounters threadAllocationCounters();
+
+/**
+ * @brief Returns the difference `after - before` of two counter snapshots.
+ */
+AllocationCounters operator-(const AllocationCounters& after, const AllocationCounters& before);
+
+#endif //SUDOKUPROJECT_ALLOC_STATS_H
@@ -0,0 +1,75 @@
+/**
+ * @file async_io.h
+ * @brief Asynchronous file I/O backends for one-file-per-puzzle corpora.
+ *
+ * This header declares an interface to keep many small file reads and writes
+ * in flight at once, plus a factory that picks the best backend available:
+ * - An io_uring backend (Linux only) that chains open, read/write and close of
+ *   each file inside the kernel, so no syscall is made per file.
+ * - A thread-pool backend using blocking I/O, used everywhere else or when
+ *   io_uring cannot be set up (old kernel, seccomp, ...).
+ *
+ * Completion callbacks may run on any thread and in any order. They must be
+ * thread-safe and must not submit new requests.
+ */
+
+#ifndef SUDOKUPROJECT_ASYNC_IO_H
+#define SUDOKUPROJECT_ASYNC_IO_H
+
+#include <functional>
+#include <memory>
+#include <string>
+using namespace std;
+
+/**
+ * @brief Called when a write has completed, with `true` on success.
+ */
+typedef function<void(bool)> WriteCallback;
+
+/**
+ * @brief Called when a read has completed, with `true` and the file content on success.
+ */
+typedef function<void(bool, string&)> ReadCallback;
+
+/**
+ * @brief Interface of an asynchronous file I/O backend.
+ */
+class FileIOBackend {
+public:
+    virtual ~FileIOBackend() = default;
+
+    /**
+     * @brief Queues a write of `content` to `path` (created or truncated).
+     *
+     * Blocks only while the maximum number of requests is already in flight.
+     */
+    virtual void submitWrite(const string& path, string content, WriteCallback done) = 0;
+
+    /**
+     * @brief Queues a read of the whole file at `path`.
+     *
+     * Blocks only while the maximum number of requests is already in flight.
+     */
+    virtual void submitRead(const string& path, ReadCallback done) = 0;
+
+    /**
+     * @brief Waits until every queued request has completed and its callback returned.
+     */
+    virtual void drain() = 0;
+
+    /**
+     * @brief Returns the name of the backend ("io_uring" or "thread-pool").
+     */
+    virtual const char* name() const = 0;
+};
+
+/**
+ * @brief Creates the best available backend.
+ *
+ * @param queueDepth Maximum number of requests kept in flight (default: 256).
+ * @param preferUring Try io_uring first when running on Linux (default: true).
+ * @return The io_uring backend if it could be initialized, otherwise a thread-pool backend.
+ */
+unique_ptr<FileIOBackend> createFileIOBackend(const unsigned& queueDepth = 256, const bool& preferUring = true);
+
+#endif //SUDOKUPROJECT_ASYNC_IO_H
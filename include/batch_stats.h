@@ -0,0 +1,92 @@
+/**
+ * @file batch_stats.h
+ * @brief Statistics of batch solving runs and their merging across shards.
+ *
+ * This header declares the counters and latency distribution collected by
+ * solveAndSaveNPuzzles(), together with functions to:
+ * - Record per-puzzle solve latencies.
+ * - Save and load statistics as a small text file (one per shard process).
+ * - Merge the statistics of several shards and print a combined report.
+ */
+
+#ifndef SUDOKUPROJECT_BATCH_STATS_H
+#define SUDOKUPROJECT_BATCH_STATS_H
+
+#include "alloc_stats.h"
+#include "latency_histogram.h"
+#include <string>
+using namespace std;
+
+/**
+ * @brief Counters and latency distribution of one batch run (or several merged runs).
+ */
+struct BatchStats {
+    long long loaded = 0;        ///< Puzzles read from the source folder.
+    long long solved = 0;        ///< Puzzles solved with a valid solution.
+    long long written = 0;       ///< Solutions written successfully.
+    long long skipped = 0;       ///< Puzzles skipped because a checkpoint recorded them.
+    long long quarantined = 0;   ///< Puzzles appended to the quarantine file (see quarantine.h).
+    double solve_seconds = 0.0;  ///< Total time spent solving and validating.
+    double wall_seconds = 0.0;   ///< Wall-clock time of the run (maximum over merged runs).
+    LatencyHistogram latency;    ///< Per-puzzle solve latencies, in nanoseconds.
+    AllocationCounters parse_allocations; ///< Heap traffic of reading and parsing the puzzles (alloc_stats.h builds only).
+    AllocationCounters solve_allocations; ///< Heap traffic of solving and validating the puzzles.
+    AllocationCounters write_allocations; ///< Heap traffic of formatting and writing the solutions, on the calling thread.
+};
+
+/**
+ * @brief Adds one solve latency to the histogram of `stats`.
+ *
+ * @param stats The statistics to update.
+ * @param seconds Time taken to solve and validate one puzzle.
+ */
+void recordSolveLatency(BatchStats& stats, const double& seconds);
+
+/**
+ * @brief Returns the given latency percentile, in microseconds.
+ *
+ * @param stats The statistics to query.
+ * @param percentile Percentile between 0 and 100.
+ * @return The percentile within the histogram precision (0.8%), 0 if no latency was recorded.
+ */
+double latencyPercentile(const BatchStats& stats, const double& percentile);
+
+/**
+ * @brief Adds the counters and histogram of `from` to `into`.
+ *
+ * Wall-clock times are combined with max() since shards run concurrently.
+ * Latency histograms merge exactly, so merged percentiles are those of the whole run.
+ */
+void mergeBatchStats(BatchStats& into, const BatchStats& from);
+
+/**
+ * @brief Writes `stats` to a text file, atomically (write-then-rename).
+ *
+ * @return `true` on success, `false` otherwise.
+ */
+bool saveBatchStats(const BatchStats& stats, const string& filename);
+
+/**
+ * @brief Reads statistics written by saveBatchStats().
+ *
+ * @return `true` on success, `false` if the file is missing or malformed.
+ */
+bool loadBatchStats(BatchStats& stats, const string& filename);
+
+/**
+ * @brief Writes the solve latencies of `stats` in the HdrHistogram percentile distribution format (microseconds).
+ *
+ * @return `true` on success, `false` otherwise.
+ */
+bool saveLatencyDistribution(const BatchStats& stats, const string& filename);
+
+/**
+ * @brief Prints counters, throughput and latency percentiles (p50 to p99.99) of `stats`,
+ *        and allocations per parse, solve and write in builds that count them.
+ *
+ * @param stats The statistics to print.
+ * @param title Title of the report.
+ */
+void printBatchReport(const BatchStats& stats, const string& title);
+
+#endif //SUDOKUPROJECT_BATCH_STATS_H
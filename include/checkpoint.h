@@ -0,0 +1,86 @@
+/**
+ * @file checkpoint.h
+ * @brief Checkpoint and resume support for long batch runs.
+ *
+ * This header declares a completion bitmap that records which puzzle indices
+ * a batch run has finished. It includes:
+ * - Thread-safe marking of completed indices (one bit per puzzle).
+ * - Periodic, atomic (write-then-rename) saving to a small binary file.
+ * - Loading a previous checkpoint so a resumed run skips finished puzzles.
+ *
+ * A 10 million puzzle run needs a 1.25 MB bitmap, so saving every few seconds
+ * is cheap compared to the run itself.
+ */
+
+#ifndef SUDOKUPROJECT_CHECKPOINT_H
+#define SUDOKUPROJECT_CHECKPOINT_H
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+using namespace std;
+
+/**
+ * @brief Bitmap of completed puzzle indices backed by a checkpoint file.
+ */
+class BatchCheckpoint {
+public:
+    /**
+     * @brief Creates an empty checkpoint.
+     *
+     * @param path File the checkpoint is saved to.
+     * @param size Number of indices tracked (indices 0 to size - 1).
+     * @param intervalSeconds Minimum time between two automatic saves (default: 5 seconds).
+     */
+    BatchCheckpoint(const string& path, const size_t& size, const double& intervalSeconds = 5.0);
+
+    /**
+     * @brief Loads the completed indices from the checkpoint file.
+     *
+     * A checkpoint saved with another size (the corpus grew or shrank) is
+     * loaded too: indices tracked by both keep their state, indices past the
+     * new size are dropped and new indices start unfinished.
+     *
+     * @return `true` if a valid checkpoint was loaded, `false` otherwise.
+     */
+    bool load();
+
+    /**
+     * @brief Saves the bitmap atomically: written to `path.tmp`, flushed, then renamed over `path`.
+     *
+     * @return `true` on success, `false` otherwise.
+     */
+    bool save();
+
+    /**
+     * @brief Returns `true` if `index` was marked as completed.
+     */
+    bool isDone(const size_t& index) const;
+
+    /**
+     * @brief Marks `index` as completed and saves the checkpoint when the interval has elapsed.
+     *
+     * Safe to call from several threads. At most one thread saves at a time;
+     * the others do not wait for it.
+     */
+    void markDone(const size_t& index);
+
+    /**
+     * @brief Returns the number of indices marked as completed.
+     */
+    size_t completed() const;
+
+private:
+    string path;
+    size_t size;
+    size_t wordCount;
+    unique_ptr<atomic<unsigned long long>[]> words;
+    atomic<size_t> doneCount;
+    chrono::steady_clock::duration interval;
+    atomic<long long> nextSave; // steady_clock ticks
+    mutex saving;
+};
+
+#endif //SUDOKUPROJECT_CHECKPOINT_H
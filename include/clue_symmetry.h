@@ -0,0 +1,111 @@
+/**
+ * @file clue_symmetry.h
+ * @brief Compile-time orbit tables for generating puzzles with symmetric clue patterns.
+ *
+ * A clue symmetry is a group of transformations of the grid. The orbit of a
+ * cell is the set of its images under the group. When the generator removes
+ * clues orbit by orbit, the clue pattern is invariant under every
+ * transformation of the group:
+ * - SYMMETRY_ROTATIONAL: 180 degree rotation, orbits of 2 cells (the center alone).
+ * - SYMMETRY_DIAGONAL: mirror on the main diagonal, orbits of 2 (diagonal cells alone).
+ * - SYMMETRY_DIHEDRAL: all 8 rotations and mirrors of the square, orbits of 1 to 8.
+ *
+ * The orbits are computed by a constexpr function like SUDOKU_TABLES, so the
+ * generator reads them from a table instead of transforming cells while it
+ * searches.
+ */
+
+#ifndef SUDOKUPROJECT_CLUE_SYMMETRY_H
+#define SUDOKUPROJECT_CLUE_SYMMETRY_H
+
+#include "sudoku_tables.h"
+
+/**
+ * @brief Symmetry of the clue positions of a generated puzzle.
+ */
+enum ClueSymmetry {
+    SYMMETRY_NONE = 0,   ///< Every cell is its own orbit.
+    SYMMETRY_ROTATIONAL, ///< Invariant under 180 degree rotation.
+    SYMMETRY_DIAGONAL,   ///< Invariant under the mirror on the main diagonal.
+    SYMMETRY_DIHEDRAL    ///< Invariant under every rotation and mirror of the square.
+};
+
+const int CLUE_SYMMETRY_COUNT = 4; ///< Number of ClueSymmetry values.
+const int MAX_ORBIT_SIZE = 8;      ///< Order of the largest group (dihedral).
+
+/**
+ * @brief The orbits of one symmetry, see CLUE_ORBITS.
+ */
+struct ClueOrbits {
+    int count;                                                    ///< Number of orbits.
+    alignas(64) unsigned char size[SUDOKU_CELLS];                 ///< Orbit -> number of cells (entries [0, count) used).
+    alignas(64) unsigned char cells[SUDOKU_CELLS][MAX_ORBIT_SIZE]; ///< Orbit -> its cells, in increasing order.
+};
+
+/**
+ * @brief Returns the image of `cell` under transformation `t` (0-7) of the dihedral group.
+ *
+ * 0 is the identity, 1-3 the rotations by 90, 180 and 270 degrees, 4 the mirror
+ * on the main diagonal, 5 on the anti-diagonal, 6 the left-right and 7 the
+ * top-bottom mirror.
+ */
+constexpr int transformCell(const int& cell, const int& t) {
+    const int r = cell / 9, c = cell % 9;
+    switch (t) {
+    case 1: return c * 9 + (8 - r);
+    case 2: return (8 - r) * 9 + (8 - c);
+    case 3: return (8 - c) * 9 + r;
+    case 4: return c * 9 + r;
+    case 5: return (8 - c) * 9 + (8 - r);
+    case 6: return r * 9 + (8 - c);
+    case 7: return (8 - r) * 9 + c;
+    default: return cell;
+    }
+}
+
+/**
+ * @brief Builds the orbits of `symmetry`; only meant to initialise CLUE_ORBITS at compile time.
+ */
+constexpr ClueOrbits makeClueOrbits(const ClueSymmetry& symmetry) {
+    // Elements of the group, the identity first
+    int group[MAX_ORBIT_SIZE] = {0};
+    int group_size = 1;
+    if (symmetry == SYMMETRY_ROTATIONAL) {
+        group[group_size++] = 2;
+    } else if (symmetry == SYMMETRY_DIAGONAL) {
+        group[group_size++] = 4;
+    } else if (symmetry == SYMMETRY_DIHEDRAL) {
+        for (int t = 1; t < MAX_ORBIT_SIZE; t++) group[group_size++] = t;
+    }
+
+    ClueOrbits orbits{};
+    bool assigned[SUDOKU_CELLS] = {};
+    for (int cell = 0; cell < SUDOKU_CELLS; cell++) {
+        if (assigned[cell]) continue;
+        // Every image of the lowest cell of an orbit is higher, so visiting cells in order keeps orbits sorted
+        bool member[SUDOKU_CELLS] = {};
+        for (int i = 0; i < group_size; i++) member[transformCell(cell, group[i])] = true;
+        int size = 0;
+        for (int other = cell; other < SUDOKU_CELLS; other++) {
+            if (!member[other]) continue;
+            orbits.cells[orbits.count][size++] = static_cast<unsigned char>(other);
+            assigned[other] = true;
+        }
+        orbits.size[orbits.count++] = static_cast<unsigned char>(size);
+    }
+    return orbits;
+}
+
+/**
+ * @brief The orbits of every ClueSymmetry, indexed by it, computed at compile time.
+ */
+inline constexpr ClueOrbits CLUE_ORBITS[CLUE_SYMMETRY_COUNT] = {
+    makeClueOrbits(SYMMETRY_NONE), makeClueOrbits(SYMMETRY_ROTATIONAL), makeClueOrbits(SYMMETRY_DIAGONAL),
+    makeClueOrbits(SYMMETRY_DIHEDRAL)};
+
+static_assert(CLUE_ORBITS[SYMMETRY_NONE].count == 81, "without symmetry every cell is an orbit");
+static_assert(CLUE_ORBITS[SYMMETRY_ROTATIONAL].count == 41, "180 degree rotation: 40 pairs and the center");
+static_assert(CLUE_ORBITS[SYMMETRY_DIAGONAL].count == 45, "diagonal mirror: 36 pairs and the 9 diagonal cells");
+static_assert(CLUE_ORBITS[SYMMETRY_DIHEDRAL].count == 15, "dihedral group: 15 orbits of the 9x9 square");
+
+#endif //SUDOKUPROJECT_CLUE_SYMMETRY_H
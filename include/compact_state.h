@@ -0,0 +1,91 @@
+/**
+ * @file compact_state.h
+ * @brief Cache-line-aligned solver state packing a whole board into three cache lines.
+ *
+ * An `int**` board spreads its 81 cells over nine separate heap rows plus the
+ * row pointer array, about ten cache lines in unrelated places, and keeps no
+ * unit masks, so every validity check reads up to 20 cells. CompactSudokuState
+ * keeps the whole hot search state in 192 contiguous, 64-byte aligned bytes:
+ * - Line 0: the 27 unit masks (16 bits each, bit k-1 set when digit k is used)
+ *   and the number of empty cells.
+ * - Lines 1-2: the 81 cells as 4-bit nibbles (41 bytes) and the list of empty
+ *   cells (81 bytes). The search keeps the cells still to fill at the front
+ *   of the list, in [0, empty_count), so choosing a cell never scans filled ones.
+ *
+ * solveCompact() (sudoku.h) searches directly on this state; the functions
+ * below convert from and to the other board representations.
+ */
+
+#ifndef SUDOKUPROJECT_COMPACT_STATE_H
+#define SUDOKUPROJECT_COMPACT_STATE_H
+
+#include "sudoku_tables.h"
+
+/**
+ * @brief The packed board, unit masks and empty-cell list of one solve.
+ */
+struct alignas(64) CompactSudokuState {
+    unsigned short row_used[9];  ///< Digits used in each row (bit k-1 for digit k).
+    unsigned short col_used[9];  ///< Digits used in each column.
+    unsigned short box_used[9];  ///< Digits used in each box.
+    unsigned char empty_count;   ///< Number of entries of `empty` still to fill.
+    alignas(64) unsigned char cells[41]; ///< Cell i in the low (even i) or high (odd i) nibble of byte i / 2; 0 when empty.
+    unsigned char empty[81];     ///< Empty cells; entries [0, empty_count) are the ones not filled yet.
+};
+
+static_assert(sizeof(CompactSudokuState) == 192, "CompactSudokuState must span exactly three cache lines");
+
+/**
+ * @brief Returns the digit of `cell` (0-80), 0 if empty.
+ */
+inline int compactCell(const CompactSudokuState& state, const int& cell) {
+    return (state.cells[cell >> 1] >> ((cell & 1) << 2)) & 0xF;
+}
+
+/**
+ * @brief Sets the digit of `cell` (0-80) without touching the masks; `k` is 0-9.
+ */
+inline void setCompactCell(CompactSudokuState& state, const int& cell, const int& k) {
+    const int shift = (cell & 1) << 2;
+    state.cells[cell >> 1] = static_cast<unsigned char>((state.cells[cell >> 1] & ~(0xF << shift)) | (k << shift));
+}
+
+/**
+ * @brief Returns the candidate digits of `cell` (bit k-1 for digit k): those missing from its three units.
+ */
+inline unsigned short compactCandidates(const CompactSudokuState& state, const int& cell) {
+    return ~(state.row_used[SUDOKU_TABLES.row_of[cell]] | state.col_used[SUDOKU_TABLES.col_of[cell]] |
+             state.box_used[SUDOKU_TABLES.box_of[cell]]) & 0x1FF;
+}
+
+/**
+ * @brief Flips the digit `bit` (a single bit, k-1 for digit k) in the three unit masks of `cell`.
+ *
+ * Placing a candidate and taking it back are the same call; the cell itself is set with setCompactCell().
+ */
+inline void toggleCompactDigit(CompactSudokuState& state, const int& cell, const unsigned short& bit) {
+    state.row_used[SUDOKU_TABLES.row_of[cell]] ^= bit;
+    state.col_used[SUDOKU_TABLES.col_of[cell]] ^= bit;
+    state.box_used[SUDOKU_TABLES.box_of[cell]] ^= bit;
+}
+
+/**
+ * @brief Fills `state` from 81 cell values in row-major order (0 for empty), as produced by parsePuzzleLine().
+ *
+ * @return `true` on success, `false` if a value is above 9 or two clues conflict.
+ */
+bool loadCompactState(const unsigned char* cells, CompactSudokuState& state);
+
+/**
+ * @brief Fills `state` from a 9x9 `int**` board.
+ *
+ * @return `true` on success, `false` if a value is outside 0-9 or two clues conflict.
+ */
+bool loadCompactState(int** BOARD, CompactSudokuState& state);
+
+/**
+ * @brief Writes the cells of `state` to a 9x9 `int**` board.
+ */
+void storeCompactState(const CompactSudokuState& state, int** BOARD);
+
+#endif //SUDOKUPROJECT_COMPACT_STATE_H
@@ -0,0 +1,72 @@
+/**
+ * @file file_manifest.h
+ * @brief Deterministic, concurrent enumeration of Sudoku puzzle folders.
+ *
+ * This header declares functions to build a sorted manifest of the puzzle
+ * files stored below a folder (flat or sharded, see FileNameLayout). It includes:
+ * - A scanner that enumerates nested folders on several threads.
+ * - Extraction of the numeric index from file names such as `0005PUZZLE.txt`.
+ * - Natural-order sorting, so the manifest order matches puzzle indices.
+ * - An optional on-disk manifest cache that is reused while no folder changed.
+ */
+
+#ifndef SUDOKUPROJECT_FILE_MANIFEST_H
+#define SUDOKUPROJECT_FILE_MANIFEST_H
+
+#include <string>
+#include <vector>
+using namespace std;
+
+/**
+ * @brief One puzzle file of a manifest.
+ */
+struct ManifestEntry {
+    long long index; ///< Index extracted from the file name, -1 if it has none.
+    string path;     ///< Path of the file, starting with the scanned folder path.
+};
+
+/**
+ * @brief Extracts the puzzle index from a file path.
+ *
+ * The index is the first run of digits of the file name (directories are
+ * ignored), e.g. 123456 for `data/puzzles/00/12/00123456PUZZLE.txt`.
+ *
+ * @param path Path of a puzzle file.
+ * @return The index, or -1 if the file name contains no digit.
+ */
+long long extractFileIndex(const string& path);
+
+/**
+ * @brief Compares two strings in natural order ("file2" < "file10").
+ *
+ * @return `true` if `a` sorts before `b`.
+ */
+bool naturalLess(const string& a, const string& b);
+
+/**
+ * @brief Enumerates every regular file below `folderPath` and returns them sorted.
+ *
+ * Folders are scanned concurrently from a shared work queue, so deep sharded
+ * trees are spread over all threads. Entries are sorted by index, then in
+ * natural order of their path.
+ *
+ * @param folderPath Folder to scan.
+ * @param threads Number of scanning threads (default: 0, one per hardware thread).
+ * @return The sorted manifest.
+ */
+vector<ManifestEntry> scanSudokuFolder(const string& folderPath, const unsigned& threads = 0);
+
+/**
+ * @brief Returns the manifest of `folderPath`, using `manifestPath` as a cache.
+ *
+ * The cache records the modification time of every scanned folder. It is used
+ * as long as none of them changed (adding or removing a file changes the time
+ * of its folder); otherwise the folder is scanned again and the cache rewritten.
+ *
+ * @param folderPath Folder to scan.
+ * @param manifestPath Cache file, or an empty string to always scan.
+ * @return The sorted manifest.
+ */
+vector<ManifestEntry> loadSudokuManifest(const string& folderPath, const string& manifestPath);
+
+#endif //SUDOKUPROJECT_FILE_MANIFEST_H
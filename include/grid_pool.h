@@ -0,0 +1,96 @@
+/**
+ * @file grid_pool.h
+ * @brief Thread-safe pool of ready full solution grids, refilled by background workers.
+ *
+ * Building a complete grid (generateFullGrid()) is most of the cost of
+ * generateBoard(); removing the clues is cheap. A GridPool keeps up to `depth`
+ * complete grids ready. When takes bring it down to half its depth, its worker
+ * threads are woken and refill it to full depth in one batch; waking them on
+ * every take would cost a context switch per request. Once a pool is installed with setGridPool()
+ * (generator.h), generateBoard() and the generators built on it take a grid
+ * from the pool and only dig holes on the calling thread.
+ *
+ * take() never waits: when the pool is empty (demand above the refill rate),
+ * the caller builds the grid itself. The pool pays off when requests leave
+ * idle time (or spare cores) for the workers; under saturation on a single
+ * core it only moves the same work to another thread.
+ */
+
+#ifndef SUDOKUPROJECT_GRID_POOL_H
+#define SUDOKUPROJECT_GRID_POOL_H
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+using namespace std;
+
+/**
+ * @brief Counters of a GridPool, see GridPool::stats().
+ */
+struct GridPoolStats {
+    long long hits = 0;     ///< take() calls served from the pool.
+    long long misses = 0;   ///< take() calls that found the pool empty and built the grid themselves.
+    long long produced = 0; ///< Grids added by the workers.
+};
+
+/**
+ * @brief Bounded pool of complete grids with background refill.
+ */
+class GridPool {
+public:
+    /**
+     * @brief Starts `workerCount` refill threads, which fill the pool up to `depth` grids right away.
+     *
+     * The workers are woken again once the pool is down to `depth / 2` grids.
+     */
+    explicit GridPool(const unsigned& depth = 256, const unsigned& workerCount = 1);
+
+    /**
+     * @brief Stops and joins the refill threads; the grids left in the pool are discarded.
+     */
+    ~GridPool();
+
+    GridPool(const GridPool&) = delete;
+    GridPool& operator=(const GridPool&) = delete;
+
+    /**
+     * @brief Writes a complete grid to `cells` (81 digits in row-major order).
+     *
+     * @return `true` if the grid came from the pool, `false` if the pool was
+     *         empty and the grid was generated on the calling thread.
+     */
+    bool take(unsigned char* cells);
+
+    /**
+     * @brief Returns the number of grids ready in the pool.
+     */
+    unsigned size() const;
+
+    /**
+     * @brief Returns the configured depth.
+     */
+    unsigned depth() const;
+
+    /**
+     * @brief Returns the counters since the pool was created.
+     */
+    GridPoolStats stats() const;
+
+private:
+    void workerLoop();
+
+    const unsigned capacity;
+    const unsigned lowWater;     // Grid count at or below which take() wakes the workers
+    vector<unsigned char> grids; // `capacity` slots of 81 cells used as a ring
+    unsigned head = 0;           // Slot of the oldest grid
+    unsigned count = 0;          // Grids ready
+    GridPoolStats counters;
+    bool refilling = true;       // Workers are filling the pool up to `capacity`
+    bool stopping = false;
+    mutable mutex lock;
+    condition_variable refillNeeded;
+    vector<thread> workers;
+};
+
+#endif //SUDOKUPROJECT_GRID_POOL_H
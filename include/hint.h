@@ -0,0 +1,118 @@
+/**
+ * @file hint.h
+ * @brief Incremental "next logical move" hint service for Sudoku players.
+ *
+ * This header declares the hint API used to suggest the easiest next step to a
+ * player instead of revealing the whole solution. It includes:
+ * - A candidate state (`HintState`) that is updated incrementally as moves are made.
+ * - Human solving techniques ordered from cheapest to most expensive.
+ * - A backtracking fallback when no logical deduction is available.
+ *
+ * Typical usage keeps one `HintState` per game, calls `syncHintState()` after the
+ * player edits the board and `nextHint()` whenever a hint is requested, so repeated
+ * calls only pay for the cells that changed.
+ */
+
+#ifndef SUDOKUPROJECT_HINT_H
+#define SUDOKUPROJECT_HINT_H
+
+/**
+ * @brief Solving techniques a hint can be based on, ordered by increasing cost.
+ */
+enum HintTechnique {
+    HINT_NONE = 0,          ///< No hint available (board solved or contradictory).
+    HINT_FULL_HOUSE,        ///< Last empty cell of a row, column or box.
+    HINT_HIDDEN_SINGLE,     ///< Digit fits in only one cell of a unit.
+    HINT_NAKED_SINGLE,      ///< Cell has only one remaining candidate.
+    HINT_LOCKED_CANDIDATES, ///< Single found after pointing/claiming eliminations.
+    HINT_NAKED_PAIR,        ///< Single found after naked pair eliminations.
+    HINT_BACKTRACKING       ///< No logical step found; digit taken from the solution.
+};
+
+/**
+ * @brief A single suggested placement.
+ *
+ * `row` and `col` are -1 and `digit` is 0 when `technique` is `HINT_NONE`.
+ */
+struct Hint {
+    int row;
+    int col;
+    int digit;
+    HintTechnique technique;
+};
+
+/**
+ * @brief Candidate state of a board, maintained incrementally between hints.
+ *
+ * Digits are stored as bitmasks where bit `k` (1-9) set means digit `k`.
+ * Eliminations made by advanced techniques are kept in `candidates`, so they
+ * are not recomputed on the next call.
+ */
+struct HintState {
+    int cells[81];                 ///< Current board in row-major order, 0 for empty.
+    unsigned short candidates[81]; ///< Remaining candidates of each empty cell.
+    unsigned short rowUsed[9];     ///< Digits placed in each row.
+    unsigned short colUsed[9];     ///< Digits placed in each column.
+    unsigned short boxUsed[9];     ///< Digits placed in each 3x3 box.
+    int emptyCount;                ///< Number of empty cells left.
+    bool contradiction;            ///< True once the board is known to be invalid.
+};
+
+/**
+ * @brief Builds the candidate state of a board from scratch.
+ *
+ * @param BOARD A dynamically allocated 9x9 Sudoku board.
+ * @param state The state to initialize.
+ */
+void initHintState(int** BOARD, HintState& state);
+
+/**
+ * @brief Places a digit and updates the candidates of all peers.
+ *
+ * @param state The state to update.
+ * @param r Row index of the move.
+ * @param c Column index of the move.
+ * @param k Digit to place (1-9).
+ * @return `true` if the move keeps the board consistent, `false` otherwise.
+ */
+bool applyHintMove(HintState& state, const int& r, const int& c, const int& k);
+
+/**
+ * @brief Brings the state in line with the current board.
+ *
+ * New placements are applied incrementally. If any cell was cleared or changed,
+ * the state is rebuilt from scratch because eliminations may no longer hold.
+ *
+ * @param state The state to update.
+ * @param BOARD A dynamically allocated 9x9 Sudoku board.
+ */
+void syncHintState(HintState& state, int** BOARD);
+
+/**
+ * @brief Returns the cheapest available deduction for the given state.
+ *
+ * Techniques are tried in the order of `HintTechnique`. Eliminations found on
+ * the way are stored in `state` so later calls start from them.
+ *
+ * @param state The candidate state of the board.
+ * @return The suggested placement, or a `HINT_NONE` hint if none exists.
+ */
+Hint nextHint(HintState& state);
+
+/**
+ * @brief Convenience overload that builds a temporary state from `BOARD`.
+ *
+ * @param BOARD A dynamically allocated 9x9 Sudoku board.
+ * @return The suggested placement, or a `HINT_NONE` hint if none exists.
+ */
+Hint nextHint(int** BOARD);
+
+/**
+ * @brief Returns a printable name for a technique (e.g. "Hidden Single").
+ *
+ * @param technique The technique to name.
+ * @return A static string with the name of the technique.
+ */
+const char* hintTechniqueName(const HintTechnique& technique);
+
+#endif //SUDOKUPROJECT_HINT_H
@@ -0,0 +1,187 @@
+/**
+ * @file latency_histogram.h
+ * @brief Lock-free, mergeable log-linear latency histogram (HdrHistogram style).
+ *
+ * This header declares a histogram of nanosecond latencies with bounded
+ * relative error, used to report tail latencies (p99, p99.99) that averages
+ * hide. It includes:
+ * - `LatencyHistogram`: fixed log-linear buckets updated with relaxed atomics,
+ *   so recording never locks and a histogram can be read while it is written.
+ * - `LatencyHistogramGroup`: one histogram per recording thread, merged on demand.
+ * - Percentile queries and export in the HdrHistogram percentile distribution
+ *   text format understood by the usual HdrHistogram plotting tools.
+ *
+ * Buckets are linear within each power of two: every power of two is split
+ * into `2^(LATENCY_SUB_BUCKET_BITS - 1)` sub-buckets, so any value is reported
+ * within 1/128 (0.8%) of its true value.
+ */
+
+#ifndef SUDOKUPROJECT_LATENCY_HISTOGRAM_H
+#define SUDOKUPROJECT_LATENCY_HISTOGRAM_H
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+using namespace std;
+
+/**
+ * @brief log2 of the number of exactly represented values (0 to 255 ns are exact).
+ */
+const int LATENCY_SUB_BUCKET_BITS = 8;
+
+/**
+ * @brief Total number of buckets needed to cover every 64-bit value.
+ */
+const int LATENCY_BUCKET_COUNT = (64 - LATENCY_SUB_BUCKET_BITS) * (1 << (LATENCY_SUB_BUCKET_BITS - 1)) + (1 << LATENCY_SUB_BUCKET_BITS);
+
+/**
+ * @brief Histogram of latencies in nanoseconds.
+ */
+class LatencyHistogram {
+public:
+    LatencyHistogram();
+    LatencyHistogram(const LatencyHistogram& other);
+    LatencyHistogram& operator=(const LatencyHistogram& other);
+
+    /**
+     * @brief Records one latency. Lock-free and safe to call from several threads.
+     *
+     * @param nanoseconds The latency to record.
+     */
+    void record(const unsigned long long& nanoseconds);
+
+    /**
+     * @brief Records one latency given in seconds.
+     */
+    void recordSeconds(const double& seconds);
+
+    /**
+     * @brief Adds every recorded value of `other` to this histogram.
+     */
+    void merge(const LatencyHistogram& other);
+
+    /**
+     * @brief Removes every recorded value.
+     */
+    void reset();
+
+    /**
+     * @brief Returns the number of recorded values.
+     */
+    unsigned long long count() const;
+
+    /**
+     * @brief Returns the smallest recorded value (0 if empty).
+     */
+    unsigned long long min() const;
+
+    /**
+     * @brief Returns the largest recorded value (0 if empty).
+     */
+    unsigned long long max() const;
+
+    /**
+     * @brief Returns the mean of the recorded values.
+     */
+    double mean() const;
+
+    /**
+     * @brief Returns the standard deviation of the recorded values, from bucket midpoints.
+     */
+    double standardDeviation() const;
+
+    /**
+     * @brief Returns the value at the given percentile.
+     *
+     * @param percentile Percentile between 0 and 100.
+     * @return The highest value of the bucket holding the percentile, clamped to max().
+     */
+    unsigned long long valueAtPercentile(const double& percentile) const;
+
+    /**
+     * @brief Writes the histogram in the HdrHistogram percentile distribution text format.
+     *
+     * @param out The stream to write to.
+     * @param unitScale Divisor applied to the values (default: 1000, microseconds).
+     * @param ticksPerHalfDistance Number of reported percentiles per halving of the distance to 100%.
+     */
+    void outputPercentileDistribution(ostream& out, const double& unitScale = 1000.0, const int& ticksPerHalfDistance = 5) const;
+
+    /**
+     * @brief Returns a one-line summary: count, mean and p50/p90/p99/p99.9/p99.99/max in microseconds.
+     */
+    string summary() const;
+
+    /**
+     * @brief Serializes the non-empty buckets as `index:count` pairs separated by spaces.
+     */
+    string serialize() const;
+
+    /**
+     * @brief Adds the buckets produced by serialize() to this histogram.
+     *
+     * @return `true` if `text` was well-formed, `false` otherwise.
+     */
+    bool deserialize(const string& text);
+
+    /**
+     * @brief Returns the bucket index of a value.
+     */
+    static int bucketIndex(const unsigned long long& value);
+
+    /**
+     * @brief Returns the smallest value of a bucket.
+     */
+    static unsigned long long bucketLowest(const int& index);
+
+    /**
+     * @brief Returns the largest value of a bucket.
+     */
+    static unsigned long long bucketHighest(const int& index);
+
+private:
+    void addBucket(const int& index, const unsigned long long& count);
+
+    unique_ptr<atomic<unsigned long long>[]> counts;
+    atomic<unsigned long long> total;
+    atomic<unsigned long long> minimum;
+    atomic<unsigned long long> maximum;
+    atomic<unsigned long long> sum;
+};
+
+/**
+ * @brief A set of per-thread histograms that are merged when read.
+ *
+ * Each thread calling local() gets its own histogram, created on first use,
+ * so threads never write to the same cache lines while recording. A thread
+ * caches only the last group it used, so the per-thread state stays one entry
+ * however many groups a long-lived thread records into.
+ */
+class LatencyHistogramGroup {
+public:
+    LatencyHistogramGroup();
+
+    /**
+     * @brief Returns the calling thread's histogram.
+     *
+     * Locks only when the thread used another group since its last call here.
+     */
+    LatencyHistogram& local();
+
+    /**
+     * @brief Returns the merge of every thread's histogram.
+     */
+    LatencyHistogram merged() const;
+
+private:
+    const unsigned long long id; // Distinguishes groups in the per-thread cache
+    mutable mutex lock;
+    vector<pair<thread::id, unique_ptr<LatencyHistogram>>> histograms;
+};
+
+#endif //SUDOKUPROJECT_LATENCY_HISTOGRAM_H
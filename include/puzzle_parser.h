@@ -0,0 +1,108 @@
+/**
+ * @file puzzle_parser.h
+ * @brief Fast parser for one-line (81 character) Sudoku puzzle files.
+ *
+ * This header declares functions to convert between the one-line puzzle
+ * format and boards. In the one-line format each puzzle is a line of 81
+ * characters in row-major order where digits `1-9` are clues and `.`, `0`
+ * or `-` mark empty cells. It includes:
+ * - A vectorized (AVX2/SSE2) line parser with a scalar fallback.
+ * - A bulk parser for whole files of puzzle lines.
+ * - Helpers to move puzzles between the flat layout and `int**` boards.
+ *
+ * The flat layout stores one puzzle as 81 consecutive `unsigned char` values
+ * (0 for empty cells), so a corpus of `n` puzzles is a single `n * 81` array.
+ */
+
+#ifndef SUDOKUPROJECT_PUZZLE_PARSER_H
+#define SUDOKUPROJECT_PUZZLE_PARSER_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+using namespace std;
+
+/**
+ * @brief Number of characters of a puzzle line, excluding the line ending.
+ */
+const int PUZZLE_LINE_LENGTH = 81;
+
+/**
+ * @brief Parses one puzzle line into the flat layout.
+ *
+ * Uses the widest vector instructions the binary was compiled for and falls
+ * back to parsePuzzleLineScalar() otherwise. `cells` may be partially written
+ * when the line is invalid.
+ *
+ * @param line Pointer to at least 81 readable characters.
+ * @param cells Destination for 81 cell values (0-9).
+ * @return `true` if every character is a digit, `.` or `-`, `false` otherwise.
+ */
+bool parsePuzzleLine(const char* line, unsigned char* cells);
+
+/**
+ * @brief Portable reference implementation of parsePuzzleLine().
+ *
+ * @param line Pointer to at least 81 readable characters.
+ * @param cells Destination for 81 cell values (0-9).
+ * @return `true` if every character is a digit, `.` or `-`, `false` otherwise.
+ */
+bool parsePuzzleLineScalar(const char* line, unsigned char* cells);
+
+/**
+ * @brief Parses a buffer containing one puzzle per line.
+ *
+ * Lines end with `\n` or `\r\n`; the last line may omit the line ending. Empty
+ * lines and lines starting with `#` are skipped. Parsed puzzles are appended
+ * to `cells` in the flat layout.
+ *
+ * @param data Buffer holding the file content.
+ * @param size Number of bytes in `data`.
+ * @param cells Vector the parsed puzzles are appended to.
+ * @param invalid Optional counter of rejected lines.
+ * @return The number of puzzles appended to `cells`.
+ */
+size_t parsePuzzleLines(const char* data, const size_t& size, vector<unsigned char>& cells, size_t* invalid = nullptr);
+
+/**
+ * @brief Reads and parses a whole one-line puzzle file.
+ *
+ * @param filename Path to the file.
+ * @param cells Vector the parsed puzzles are appended to.
+ * @param invalid Optional counter of rejected lines.
+ * @return `true` if the file could be read, `false` otherwise.
+ */
+bool readPuzzleLineFile(const string& filename, vector<unsigned char>& cells, size_t* invalid = nullptr);
+
+/**
+ * @brief Formats a board as a puzzle line, using `.` for empty cells.
+ *
+ * @param BOARD A pointer to the 2D Sudoku board (int**).
+ * @param line Destination for 81 characters (not null-terminated).
+ */
+void formatPuzzleLine(int** BOARD, char* line);
+
+/**
+ * @brief Copies a puzzle from the flat layout into a board.
+ *
+ * @param cells 81 cell values in row-major order.
+ * @param BOARD A dynamically allocated 9x9 Sudoku board to fill.
+ */
+void cellsToBoard(const unsigned char* cells, int** BOARD);
+
+/**
+ * @brief Copies a board into the flat layout.
+ *
+ * @param BOARD A pointer to the 2D Sudoku board (int**).
+ * @param cells Destination for 81 cell values in row-major order.
+ */
+void boardToCells(int** BOARD, unsigned char* cells);
+
+/**
+ * @brief Returns the instruction set used by parsePuzzleLine().
+ *
+ * @return "avx2", "sse2" or "scalar".
+ */
+const char* puzzleParserBackend();
+
+#endif //SUDOKUPROJECT_PUZZLE_PARSER_H
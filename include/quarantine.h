@@ -0,0 +1,64 @@
+/**
+ * @file quarantine.h
+ * @brief Capture of slow puzzles into a quarantine corpus file.
+ *
+ * When a batch solve exceeds a latency or search-node threshold, the puzzle is
+ * appended to a quarantine file together with its solve statistics and the
+ * strategy used. The file grows into a regression set of exactly the inputs
+ * that hurt tail latency; `SudokuBench replay` solves it again.
+ *
+ * File format: a `# sudoku quarantine v1` header, then one record per line:
+ * `<81-character puzzle> <strategy> <seconds> <nodes> <solved 0/1> <source>`,
+ * where the puzzle uses '.' for empty cells (see formatPuzzleLine()).
+ */
+
+#ifndef SUDOKUPROJECT_QUARANTINE_H
+#define SUDOKUPROJECT_QUARANTINE_H
+
+#include <string>
+#include <vector>
+using namespace std;
+
+/**
+ * @brief One quarantined solve.
+ */
+struct QuarantineRecord {
+    string puzzle;           ///< The unsolved puzzle, as an 81-character line.
+    string strategy;         ///< Solver strategy (see solverStrategyName()).
+    double seconds = 0.0;    ///< Time taken to solve and validate.
+    long long nodes = 0;     ///< Search nodes visited by the solver.
+    bool solved = false;     ///< Whether a valid solution was found.
+    string source;           ///< File the puzzle came from, or "-".
+};
+
+/**
+ * @brief Returns `true` if a solve exceeded one of the enabled thresholds.
+ *
+ * @param seconds Time taken by the solve.
+ * @param nodes Search nodes visited by the solve.
+ * @param max_seconds Latency threshold in seconds, or 0 to disable.
+ * @param max_nodes Node threshold, or 0 to disable.
+ */
+bool exceedsQuarantineThresholds(const double& seconds, const long long& nodes, const double& max_seconds,
+                                 const long long& max_nodes);
+
+/**
+ * @brief Appends one record to a quarantine file, writing the header if the file is new.
+ *
+ * Each record is written with a single append, so several threads or shard
+ * processes can share one quarantine file.
+ *
+ * @return `true` on success, `false` otherwise.
+ */
+bool appendQuarantineRecord(const string& filename, const QuarantineRecord& record);
+
+/**
+ * @brief Reads every record of a quarantine file.
+ *
+ * @param filename The quarantine file.
+ * @param records Receives the records; malformed lines are skipped.
+ * @return `true` if the file could be opened and has a valid header, `false` otherwise.
+ */
+bool loadQuarantine(const string& filename, vector<QuarantineRecord>& records);
+
+#endif //SUDOKUPROJECT_QUARANTINE_H
@@ -0,0 +1,41 @@
+/**
+ * @file shard_runner.h
+ * @brief Local multi-process runner for sharded batch jobs.
+ *
+ * A corpus is split into `shard_count` contiguous index ranges (see
+ * BatchOptions::shard_index). This header declares a function that starts one
+ * independent SudokuProject process per shard on the local machine, waits for
+ * all of them and merges the statistics they wrote. No external scheduler is
+ * involved.
+ */
+
+#ifndef SUDOKUPROJECT_SHARD_RUNNER_H
+#define SUDOKUPROJECT_SHARD_RUNNER_H
+
+#include "batch_stats.h"
+#include <string>
+#include <vector>
+using namespace std;
+
+/**
+ * @brief Returns the statistics file of shard `shard_index`: `stats_prefix<shard_index>.stats`.
+ */
+string getShardStatsFileName(const string& stats_prefix, const int& shard_index);
+
+/**
+ * @brief Runs one process per shard and merges their statistics.
+ *
+ * Shard `k` is started as
+ * `executable <arguments...> --shard k/shard_count --stats-out <stats file of k>`.
+ *
+ * @param executable Path of the SudokuProject executable (usually `argv[0]`).
+ * @param shard_count Number of shards, hence of processes.
+ * @param arguments Arguments given to every shard process.
+ * @param stats_prefix Prefix of the per-shard statistics files.
+ * @param merged Receives the merged statistics of the shards that succeeded.
+ * @return The number of shards that failed (non-zero exit or missing statistics).
+ */
+int runShardedJob(const string& executable, const int& shard_count, const vector<string>& arguments,
+                  const string& stats_prefix, BatchStats& merged);
+
+#endif //SUDOKUPROJECT_SHARD_RUNNER_H
@@ -0,0 +1,79 @@
+/**
+ * @file solver_trail.h
+ * @brief Undo log ("trail") for backtracking over arbitrary solver state.
+ *
+ * Instead of copying the solver state before each guess, every mutation goes
+ * through SolverTrail::set(), which records the slot and its previous value.
+ * Before a guess the search takes a mark(); when the guess fails, undo(mark)
+ * restores every slot changed since, newest first. A guess therefore costs
+ * only what it changes, and the trail lives in a fixed array, so a search of
+ * any depth does no copying and no allocation.
+ *
+ * Usage:
+ * @code
+ *     SolverTrail<unsigned short, 2048> trail;
+ *     const int mark = trail.mark();
+ *     trail.set(candidates[cell], candidates[cell] & ~bit);
+ *     ...
+ *     trail.undo(mark); // candidates[cell] is back to its old value
+ * @endcode
+ */
+
+#ifndef SUDOKUPROJECT_SOLVER_TRAIL_H
+#define SUDOKUPROJECT_SOLVER_TRAIL_H
+
+/**
+ * @brief Fixed-capacity undo log of assignments to slots of type `T`.
+ *
+ * @tparam T Type of the state slots (all state tracked by one trail shares it).
+ * @tparam Capacity Maximum number of assignments recorded at once. The caller
+ *         must size it for the deepest search: nothing checks it at run time.
+ */
+template <class T, int Capacity>
+class SolverTrail {
+public:
+    /**
+     * @brief Returns the current position, to be passed to undo().
+     */
+    int mark() const {
+        return size;
+    }
+
+    /**
+     * @brief Assigns `value` to `slot`, recording its old value.
+     */
+    void set(T& slot, const T& value) {
+        entries[size].slot = &slot;
+        entries[size].previous = slot;
+        size++;
+        slot = value;
+    }
+
+    /**
+     * @brief Restores every slot assigned since `mark` was taken, newest first.
+     */
+    void undo(const int& mark) {
+        while (size > mark) {
+            size--;
+            *entries[size].slot = entries[size].previous;
+        }
+    }
+
+    /**
+     * @brief Returns the number of assignments currently recorded.
+     */
+    int depth() const {
+        return size;
+    }
+
+private:
+    struct Entry {
+        T* slot;
+        T previous;
+    };
+
+    Entry entries[Capacity];
+    int size = 0;
+};
+
+#endif //SUDOKUPROJECT_SOLVER_TRAIL_H
@@ -22,6 +22,9 @@
 #define SUDOKUPROJECT_SUDOKU_H
 
 #include <iostream>
+#include <string>
+
+struct CompactSudokuState;
 
 /**
  * @brief Validates if a number can be placed in a specific cell of the Sudoku board.
@@ -88,6 +91,72 @@ std::tuple<int, int, int> findNextCell(int** BOARD);
  */
 bool solveBoardEfficient(int** BOARD);
 
+/**
+ * @brief Solves the Sudoku board with candidate bitmasks, constraint propagation and an undo trail.
+ *
+ * Keeps a candidate mask per cell. Placing a digit removes it from the 20
+ * peers, and any peer left with a single candidate is placed in turn (naked
+ * singles); a peer left with none is a contradiction. The search branches on
+ * the cell with the fewest candidates. Every state change is recorded in a
+ * SolverTrail (solver_trail.h), so a failed branch is undone without copying
+ * the state, and the search allocates nothing.
+ *
+ * @param BOARD A dynamically allocated 9x9 Sudoku board.
+ * @return `true` if the board is successfully solved (BOARD then holds the solution),
+ *         `false` otherwise (BOARD is left unchanged).
+ */
+bool solveBoardPropagation(int** BOARD);
+
+/**
+ * @brief Solves a CompactSudokuState in place with bitmask MRV backtracking.
+ *
+ * Candidates of a cell are the digits missing from its three unit masks; the
+ * search picks the unfilled cell with the fewest candidates from the state's
+ * empty-cell list. The whole search touches only the 192 bytes of the state.
+ *
+ * @param state A state loaded with loadCompactState() (compact_state.h).
+ * @return `true` if solved (the state holds the solution), `false` otherwise
+ *         (the state is left as it was given).
+ */
+bool solveCompact(CompactSudokuState& state);
+
+/**
+ * @brief Counts the solutions of a CompactSudokuState, stopping at `limit`.
+ *
+ * Same search as solveCompact(), but it explores every branch until `limit`
+ * solutions are found and always restores the state before returning (the
+ * order of the unfilled entries of the empty-cell list may change). Because
+ * the state is left intact, a caller can edit a few cells and count again
+ * without reloading it; the puzzle generator uses this to test each clue
+ * removal incrementally. The nodes are not added to getSolveNodeCount() and
+ * the node limit does not apply.
+ *
+ * @param state A state loaded with loadCompactState() (compact_state.h).
+ * @param limit Number of solutions after which the count stops (1 tests solvability, 2 uniqueness).
+ * @return The number of solutions, at most `limit`.
+ */
+int countCompactSolutions(CompactSudokuState& state, const int& limit);
+
+/**
+ * @brief Solves the Sudoku board by converting it to a CompactSudokuState and calling solveCompact().
+ *
+ * @param BOARD A dynamically allocated 9x9 Sudoku board.
+ * @return `true` if the board is successfully solved, `false` otherwise (BOARD is left unchanged).
+ */
+bool solveBoardCompact(int** BOARD);
+
+/**
+ * @brief Solver strategies selectable through solve().
+ */
+enum SolverStrategy {
+    SOLVE_BACKTRACKING = 0, ///< solveBoard(): row-major backtracking.
+    SOLVE_MRV,              ///< solveBoardEfficient(): backtracking on the most constrained cell.
+    SOLVE_PROPAGATION,      ///< solveBoardPropagation(): candidate masks, naked singles and an undo trail.
+    SOLVE_COMPACT           ///< solveBoardCompact(): bitmask MRV backtracking on a CompactSudokuState.
+};
+
+const int SOLVER_STRATEGY_COUNT = 4; ///< Number of SolverStrategy values.
+
 /**
  * @brief Solves the Sudoku board using either basic or efficient solving methods.
  *
@@ -102,4 +171,59 @@ bool solveBoardEfficient(int** BOARD);
  */
 bool solve(int** board, const bool& efficient = false);
 
+/**
+ * @brief Solves the Sudoku board with the given strategy.
+ *
+ * Applies the node limit (see setSolveNodeLimit()) like the flag variant.
+ *
+ * @param board A dynamically allocated 9x9 Sudoku board.
+ * @param strategy The solver to use.
+ * @return `true` if the board is successfully solved, `false` otherwise.
+ */
+bool solve(int** board, const SolverStrategy& strategy);
+
+/**
+ * @brief Returns the name of the solving strategy selected by the `efficient` flag of solve().
+ *
+ * @return "backtracking" or "mrv-backtracking".
+ */
+const char* solverStrategyName(const bool& efficient);
+
+/**
+ * @brief Returns the name of a solver strategy.
+ *
+ * @return "backtracking", "mrv-backtracking", "propagation" or "compact-mrv".
+ */
+const char* solverStrategyName(const SolverStrategy& strategy);
+
+/**
+ * @brief Looks up a strategy by the name returned by solverStrategyName().
+ *
+ * @return `true` and sets `strategy` if `name` is known, `false` otherwise.
+ */
+bool solverStrategyFromName(const std::string& name, SolverStrategy& strategy);
+
+/**
+ * @brief Returns the number of search nodes (digits placed) by the solvers on the calling thread.
+ *
+ * The counter is thread-local and keeps growing across calls; read it before and
+ * after solve() to obtain the work done by one solve.
+ */
+long long getSolveNodeCount();
+
+/**
+ * @brief Limits the number of search nodes of every following solve() on the calling thread.
+ *
+ * A solve reaching the limit gives up: it returns `false` and leaves the board
+ * as it was given. Used to keep benchmarks on adversarial puzzles bounded.
+ *
+ * @param limit Maximum number of nodes per solve, or 0 for no limit (the default).
+ */
+void setSolveNodeLimit(const long long& limit);
+
+/**
+ * @brief Returns `true` if the last solve() on the calling thread gave up at the node limit.
+ */
+bool solveHitNodeLimit();
+
 #endif //SUDOKUPROJECT_SUDOKU_H
\ No newline at end of file
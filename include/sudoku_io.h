@@ -23,10 +23,94 @@
 #ifndef SUDOKUPROJECT_SUDOKUIO_H
 #define SUDOKUPROJECT_SUDOKUIO_H
 
+#include "generator.h"
 #include <vector>
 #include <string>
 using namespace std;
 
+class FileIOBackend;
+struct BatchStats;
+
+/**
+ * @brief Optional settings of the batch functions createAndSaveNPuzzles() and solveAndSaveNPuzzles().
+ *
+ * The default values reproduce the original behaviour (blocking I/O, one file at a time).
+ */
+struct BatchOptions {
+    /// Asynchronous file backend (see async_io.h) used to keep many reads/writes in flight,
+    /// or nullptr for blocking I/O. The caller owns the backend.
+    FileIOBackend* io = nullptr;
+
+    /// Manifest cache used by solveAndSaveNPuzzles() to skip rescanning the source folder
+    /// (see loadSudokuManifest()), or an empty string to always scan.
+    string manifest_path;
+
+    /// Checkpoint file recording the puzzles solveAndSaveNPuzzles() has finished (see checkpoint.h),
+    /// or an empty string to disable checkpoints.
+    string checkpoint_path;
+
+    /// Skip the puzzles recorded in `checkpoint_path` by a previous run.
+    bool resume = false;
+
+    /// Minimum number of seconds between two checkpoint saves.
+    double checkpoint_interval = 5.0;
+
+    /// solveAndSaveNPuzzles() only processes shard `shard_index` of `shard_count`: the
+    /// contiguous range [n * shard_index / shard_count, n * (shard_index + 1) / shard_count)
+    /// of the n puzzles sorted by index (see shard_runner.h).
+    int shard_index = 0;
+    int shard_count = 1;
+
+    /// createAndSaveNPuzzles() generates minimal puzzles with generateMinimalBoard() (see generator.h)
+    /// and ignores the requested number of empty cells.
+    bool minimal_puzzles = false;
+
+    /// createAndSaveNPuzzles() generates puzzles with the requested number of empty cells and a
+    /// unique solution with generateUniqueBoard() (see generator.h); ignored with `minimal_puzzles`.
+    bool unique_puzzles = false;
+
+    /// Symmetry of the clue pattern of minimal and unique puzzles (see clue_symmetry.h).
+    ClueSymmetry clue_symmetry = SYMMETRY_NONE;
+
+    /// Order in which minimal and unique puzzle generation tries to remove clues (see generator.h).
+    RemovalOrder removal_order = REMOVAL_RANDOM;
+
+    /// Receives the counters and latencies of solveAndSaveNPuzzles() (see batch_stats.h), or nullptr.
+    BatchStats* stats = nullptr;
+
+    /// Quarantine file receiving the puzzles whose solve exceeds `quarantine_seconds` or
+    /// `quarantine_nodes` (see quarantine.h), or an empty string to disable quarantine.
+    string quarantine_path;
+    double quarantine_seconds = 0.0;  ///< Latency threshold in seconds, 0 to disable.
+    long long quarantine_nodes = 0;   ///< Search node threshold, 0 to disable.
+};
+
+/**
+ * @brief Size of a buffer large enough for any board rendered by renderBoard(),
+ *        including the terminal color codes.
+ */
+const int BOARD_TEXT_BUFFER_SIZE = 1024;
+
+/**
+ * @brief Renders the Sudoku board into a caller-provided character buffer.
+ *
+ * Produces the same layout as printBoard() and boardToString() without any heap
+ * allocation: a precomputed row template supplies the separators and each cell
+ * glyph (plain or color-coded) is copied from a precomputed glyph table. Cell
+ * values and candidates outside 0-9 are drawn as '?'. The output is not
+ * null-terminated.
+ *
+ * @param BOARD A pointer to the 2D Sudoku board (int**).
+ * @param buffer Destination buffer of at least `BOARD_TEXT_BUFFER_SIZE` bytes.
+ * @param r Row index for the candidate (default: 0).
+ * @param c Column index for the candidate (default: 0).
+ * @param k Candidate number to test (default: 0, no candidate highlighted).
+ * @param color Use terminal coloring for empty and candidate cells (default: false).
+ * @param empty Character used for empty cells in plain mode (default: '-').
+ * @return The number of bytes written to `buffer`.
+ */
+int renderBoard(int** BOARD, char* buffer, const int& r=0, const int& c=0, int k=0, const bool& color=false, const char& empty='-');
+
 /**
  * @brief Prints the Sudoku board to the console with highlighting.
  *
@@ -48,7 +132,7 @@ void printBoard(int** BOARD, const int& r=0, const int& c=0, int k=0, const bool
  * @brief Converts the Sudoku board into a string representation.
  *
  * Converts the 9x9 board into a string format, using '-' for empty cells.
- * Includes separators for readability.
+ * Includes separators for readability. The board is appended to `content`.
  *
  * @param BOARD A pointer to the 2D Sudoku board (int**).
  * @param content Reference to a string where the board will be stored.
@@ -99,6 +183,14 @@ void extractNumbers(const string& input, vector<int>& numbers);
  */
 void fillBoard(const vector<int>& numbers, int** BOARD);
 
+/**
+ * @brief Parses a Sudoku board from the text written by writeSudokuToFile().
+ *
+ * @param sudoku The content of a Sudoku puzzle file.
+ * @return A pointer to a dynamically allocated 2D Sudoku board.
+ */
+int** readSudokuFromString(string sudoku);
+
 /**
  * @brief Reads a Sudoku board from a file.
  *
@@ -126,12 +218,14 @@ bool checkIfSolutionIsValid(int** BOARD);
 /**
  * @brief Retrieves all Sudoku puzzle filenames in a given folder.
  *
- * Scans the specified folder and returns paths to all Sudoku puzzle files.
+ * Scans the specified folder, including shard sub-folders, and returns paths to
+ * all Sudoku puzzle files sorted by the index in their file name (see file_manifest.h).
  *
  * @param folderPath Path to the folder containing Sudoku puzzles.
+ * @param manifestPath Optional manifest cache file, kept outside `folderPath` (default: none).
  * @return A vector of file paths to the Sudoku puzzles.
  */
-vector<string> getAllSudokuInFolder(const string& folderPath);
+vector<string> getAllSudokuInFolder(const string& folderPath, const string& manifestPath = "");
 
 /**
  * @brief Generates and saves multiple Sudoku puzzles.
@@ -139,24 +233,44 @@ vector<string> getAllSudokuInFolder(const string& folderPath);
  * Generates `num_puzzles` new Sudoku boards and saves them as text files
  * in the specified destination folder with filenames prefixed by `prefix`.
  *
+ * When `options.io` is set, the files are written through the asynchronous
+ * backend and only a summary is printed.
+ *
  * @param num_puzzles The number of puzzles to generate.
+ * @param complexity_empty_boxes Number of empty cells of each generated puzzle.
  * @param destination Folder where the puzzles will be saved.
  * @param prefix Filename prefix for the saved puzzles.
+ * @param options Optional batch settings (default: blocking I/O).
  */
-void createAndSaveNPuzzles(const int& num_puzzles, const int& complexity_empty_boxes, const string& destination, const string& prefix);
+void createAndSaveNPuzzles(const int& num_puzzles, const int& complexity_empty_boxes, const string& destination, const string& prefix, const BatchOptions& options = BatchOptions());
 
 /**
  * @brief Solves and saves multiple Sudoku puzzles from a source folder.
  *
  * Reads unsolved puzzles from `source`, solves them, and saves the
- * solutions to `destination` with filenames prefixed by `prefix`.
+ * solutions to `destination` with filenames prefixed by `prefix`. Each
+ * solution gets the index found in the file name of its puzzle.
+ *
+ * With `options.checkpoint_path` set, every written solution is recorded in a
+ * checkpoint saved every `options.checkpoint_interval` seconds and at the end;
+ * with `options.resume` the puzzles already recorded are skipped.
+ *
+ * When `options.io` is set, puzzles are read in windows of `ASYNC_IO_WINDOW`
+ * files: the next window is being read while the current one is solved and
+ * its solutions are written, and only a summary is printed.
  *
  * @param num_puzzles The number of puzzles to solve.
  * @param source Folder containing unsolved puzzles.
  * @param destination Folder where solved puzzles will be saved.
  * @param prefix Filename prefix for the saved solutions.
+ * @param options Optional batch settings (default: blocking I/O).
+ */
+void solveAndSaveNPuzzles(const int& num_puzzles, const string& source, const string& destination, const string& prefix, const BatchOptions& options = BatchOptions());
+
+/**
+ * @brief Number of puzzle files read ahead by solveAndSaveNPuzzles() with an asynchronous backend.
  */
-void solveAndSaveNPuzzles(const int& num_puzzles, const string& source, const string& destination, const string& prefix);
+const int ASYNC_IO_WINDOW = 256;
 
 /**
  * @brief Performs a deep copy of a 9x9 Sudoku board.
@@ -0,0 +1,117 @@
+/**
+ * @file sudoku_tables.h
+ * @brief Compile-time geometry tables of the 9x9 grid shared by the solvers, the validator,
+ *        the generator and the hint service.
+ *
+ * Cells are numbered 0-80 in row-major order (`cell = r * 9 + c`). Units are
+ * numbered 0-26: rows 0-8, columns 9-17 and boxes 18-26, boxes in row-major
+ * order. The tables are built by a constexpr function, so lookups replace the
+ * `3 * (r / 3)` arithmetic and hand-written unit loops without any run-time
+ * initialisation. Each table starts on its own cache line; all of them
+ * together take about 2.6 KB and stay in L1 while solving.
+ */
+
+#ifndef SUDOKUPROJECT_SUDOKU_TABLES_H
+#define SUDOKUPROJECT_SUDOKU_TABLES_H
+
+const int SUDOKU_CELLS = 81;  ///< Cells of the grid.
+const int SUDOKU_UNITS = 27;  ///< Rows, columns and boxes.
+const int SUDOKU_PEERS = 20;  ///< Cells sharing a row, column or box with a given cell, itself excluded.
+
+/**
+ * @brief Index of the first box-only peer in SudokuTables::peers.
+ *
+ * The peers of a cell are stored as the 8 other cells of its row, then the 8
+ * other cells of its column, then the 4 cells of its box outside both, each
+ * group in increasing order. Code that already scans the row and the column
+ * only needs the last 4.
+ */
+const int SUDOKU_BOX_ONLY_PEERS = 16;
+
+/**
+ * @brief The geometry tables, see SUDOKU_TABLES.
+ */
+struct SudokuTables {
+    alignas(64) unsigned char row_of[SUDOKU_CELLS];              ///< Cell -> row (0-8).
+    alignas(64) unsigned char col_of[SUDOKU_CELLS];              ///< Cell -> column (0-8).
+    alignas(64) unsigned char box_of[SUDOKU_CELLS];              ///< Cell -> box (0-8).
+    alignas(64) unsigned char unit_cells[SUDOKU_UNITS][9];       ///< Unit -> its 9 cells; box b is unit 18 + b.
+    alignas(64) unsigned char cell_units[SUDOKU_CELLS][3];       ///< Cell -> {row unit, column unit, box unit}.
+    alignas(64) unsigned char peers[SUDOKU_CELLS][SUDOKU_PEERS]; ///< Cell -> its 20 peers, see SUDOKU_BOX_ONLY_PEERS.
+};
+
+/**
+ * @brief Builds the tables; only meant to initialise SUDOKU_TABLES at compile time.
+ */
+constexpr SudokuTables makeSudokuTables() {
+    SudokuTables tables{};
+    for (int cell = 0; cell < SUDOKU_CELLS; cell++) {
+        const int r = cell / 9, c = cell % 9, b = (r / 3) * 3 + c / 3;
+        tables.row_of[cell] = static_cast<unsigned char>(r);
+        tables.col_of[cell] = static_cast<unsigned char>(c);
+        tables.box_of[cell] = static_cast<unsigned char>(b);
+        tables.cell_units[cell][0] = static_cast<unsigned char>(r);
+        tables.cell_units[cell][1] = static_cast<unsigned char>(9 + c);
+        tables.cell_units[cell][2] = static_cast<unsigned char>(18 + b);
+    }
+    for (int i = 0; i < 9; i++) {
+        for (int j = 0; j < 9; j++) {
+            tables.unit_cells[i][j] = static_cast<unsigned char>(i * 9 + j);
+            tables.unit_cells[9 + i][j] = static_cast<unsigned char>(j * 9 + i);
+            tables.unit_cells[18 + i][j] = static_cast<unsigned char>(((i / 3) * 3 + j / 3) * 9 + (i % 3) * 3 + j % 3);
+        }
+    }
+    for (int cell = 0; cell < SUDOKU_CELLS; cell++) {
+        const int r = tables.row_of[cell], c = tables.col_of[cell], b = tables.box_of[cell];
+        int count = 0;
+        for (int other = 0; other < SUDOKU_CELLS; other++) {
+            if (other != cell && tables.row_of[other] == r) tables.peers[cell][count++] = static_cast<unsigned char>(other);
+        }
+        for (int other = 0; other < SUDOKU_CELLS; other++) {
+            if (other != cell && tables.col_of[other] == c) tables.peers[cell][count++] = static_cast<unsigned char>(other);
+        }
+        for (int other = 0; other < SUDOKU_CELLS; other++) {
+            if (tables.box_of[other] == b && tables.row_of[other] != r && tables.col_of[other] != c) {
+                tables.peers[cell][count++] = static_cast<unsigned char>(other);
+            }
+        }
+    }
+    return tables;
+}
+
+/**
+ * @brief The grid geometry, computed at compile time.
+ */
+inline constexpr SudokuTables SUDOKU_TABLES = makeSudokuTables();
+
+static_assert(SUDOKU_TABLES.peers[0][SUDOKU_BOX_ONLY_PEERS - 1] == 72 && SUDOKU_TABLES.peers[0][SUDOKU_PEERS - 1] == 20,
+              "peers of cell 0: row, then column ending at (8, 0), then box ending at (2, 2)");
+static_assert(SUDOKU_TABLES.unit_cells[26][8] == 80, "the last box must end with the last cell");
+
+/**
+ * @brief Returns the number of set bits of a candidate or digit mask.
+ */
+inline int countMaskBits(unsigned int mask) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_popcount(mask);
+#else
+    int count = 0;
+    for (; mask; mask &= mask - 1) count++;
+    return count;
+#endif
+}
+
+/**
+ * @brief Returns the index of the lowest set bit of a non-zero mask.
+ */
+inline int lowestMaskBit(unsigned int mask) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctz(mask);
+#else
+    int bit = 0;
+    while (!(mask & (1u << bit))) bit++;
+    return bit;
+#endif
+}
+
+#endif //SUDOKUPROJECT_SUDOKU_TABLES_H
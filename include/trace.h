@@ -0,0 +1,86 @@
+/**
+ * @file trace.h
+ * @brief Scoped trace events exported as Chrome trace JSON.
+ *
+ * This header declares a lightweight tracer for the generate/solve/write
+ * pipeline. A `SUDOKU_TRACE_SCOPE("name")` statement records how long the
+ * enclosing scope took on the current thread. Events go to a fixed-size ring
+ * buffer owned by each thread (no locking while recording), and
+ * writeChromeTrace() dumps every buffer in the Chrome trace event format, which
+ * chrome://tracing and ui.perfetto.dev open directly.
+ *
+ * Trace scopes compile to nothing unless `SUDOKU_ENABLE_TRACE` is defined
+ * (CMake option `SUDOKU_ENABLE_TRACE`), so they cost nothing in normal builds.
+ */
+
+#ifndef SUDOKUPROJECT_TRACE_H
+#define SUDOKUPROJECT_TRACE_H
+
+#include <string>
+using namespace std;
+
+/**
+ * @brief Number of events kept per thread; older events are overwritten.
+ */
+const int TRACE_RING_CAPACITY = 1 << 16;
+
+/**
+ * @brief Returns `true` if trace scopes were compiled in.
+ */
+bool traceCompiledIn();
+
+/**
+ * @brief Names the calling thread in the exported trace (e.g. "main", "io-worker").
+ */
+void setTraceThreadName(const string& name);
+
+/**
+ * @brief Records a complete event on the calling thread's ring buffer.
+ *
+ * @param name Event name; must outlive the trace (a string literal).
+ * @param start_ns Start time, from traceNow().
+ * @param end_ns End time, from traceNow().
+ */
+void recordTraceEvent(const char* name, const long long& start_ns, const long long& end_ns);
+
+/**
+ * @brief Returns the trace clock in nanoseconds (monotonic).
+ */
+long long traceNow();
+
+/**
+ * @brief Writes the events of every thread as Chrome trace JSON.
+ *
+ * Call it when the traced threads are idle (e.g. at the end of a run):
+ * events recorded while the file is written may be missing or torn.
+ *
+ * @param filename Output file, conventionally with a `.json` extension.
+ * @return `true` on success, `false` otherwise.
+ */
+bool writeChromeTrace(const string& filename);
+
+/**
+ * @brief Records the lifetime of a scope as one trace event.
+ */
+class TraceScope {
+public:
+    explicit TraceScope(const char* name) : name(name), start(traceNow()) {}
+    ~TraceScope() { recordTraceEvent(name, start, traceNow()); }
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+
+private:
+    const char* name;
+    const long long start;
+};
+
+#define SUDOKU_TRACE_CONCAT_INNER(a, b) a##b
+#define SUDOKU_TRACE_CONCAT(a, b) SUDOKU_TRACE_CONCAT_INNER(a, b)
+
+#ifdef SUDOKU_ENABLE_TRACE
+#define SUDOKU_TRACE_SCOPE(name) TraceScope SUDOKU_TRACE_CONCAT(sudoku_trace_scope_, __LINE__)(name)
+#else
+#define SUDOKU_TRACE_SCOPE(name) do {} while (0)
+#endif
+
+#endif //SUDOKUPROJECT_TRACE_H
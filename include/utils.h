@@ -52,12 +52,59 @@ void createFolder(const string& folderPath);
  */
 void initDataFolder();
 
+/**
+ * @brief Layout of the file names produced by getFileName().
+ *
+ * The default layout is the original flat one (`destination/0005PUZZLE.txt`).
+ * With `shard_levels > 0` the leading digits of the padded index select nested
+ * shard directories, e.g. index 123456 with `{8, 2, 2}` gives
+ * `destination/00/12/00123456PUZZLE.txt`, which keeps every directory at most
+ * 10^(index_width - shard_levels * shard_width) files.
+ */
+struct FileNameLayout {
+    int index_width = 4;  ///< Minimum number of digits of the index (zero padded).
+    int shard_levels = 0; ///< Number of shard directory levels (0 = flat directory).
+    int shard_width = 2;  ///< Digits of the padded index used by each shard level.
+};
+
+/**
+ * @brief Returns the recommended layout for very large corpora: 8-digit indices and two shard levels.
+ */
+FileNameLayout shardedFileNameLayout();
+
+/**
+ * @brief Sets the layout used by getFileName().
+ *
+ * Must be called before any batch function runs; it is not synchronized.
+ *
+ * @param layout The layout to use from now on.
+ */
+void setFileNameLayout(const FileNameLayout& layout);
+
+/**
+ * @brief Returns the layout currently used by getFileName().
+ */
+const FileNameLayout& getFileNameLayout();
+
+/**
+ * @brief Creates the directory containing `filename`, and its parents, if needed.
+ *
+ * Directories already created by this function are remembered, so calling it
+ * for every file of a batch costs a hash lookup rather than a filesystem check.
+ * Thread-safe and silent.
+ *
+ * @param filename Path of a file about to be written.
+ * @return `true` if the directory exists, `false` if it could not be created.
+ */
+bool createParentFolders(const string& filename);
+
 /**
  * @brief Generates a formatted filename with zero-padded index.
  *
  * Constructs a filename using a zero-padded index, a destination path, and a prefix.
- * The filename follows the pattern: `destination/XXXXprefix.txt`, where `XXXX` is the
- * zero-padded index (e.g., `0001puzzle.txt`).
+ * With the default layout the filename follows the pattern: `destination/XXXXprefix.txt`,
+ * where `XXXX` is the zero-padded index (e.g., `0001puzzle.txt`). Indices wider than the
+ * layout's `index_width` are written in full. See FileNameLayout for sharded layouts.
  *
  * @param index The numerical index to include in the filename.
  * @param destination The directory where the file will be saved.
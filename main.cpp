@@ -1,8 +1,17 @@
 #include "include/generator.h"
+#include "include/grid_pool.h"
 #include "include/sudoku.h"
 #include "include/sudoku_io.h"
 #include "include/utils.h"
+#include "include/hint.h"
+#include "include/async_io.h"
+#include "include/file_manifest.h"
+#include "include/batch_stats.h"
+#include "include/shard_runner.h"
+#include "include/trace.h"
 #include <iostream>
+#include <cstdio>
+#include <cstdlib>
 
 using namespace std;
 
@@ -42,6 +51,11 @@ int main() {
     cout << "Generated Sudoku Puzzle:\n";
     printBoard(board);  // Assuming printBoard is defined in sudoku_io.h
 
+    // Ask the hint service for the easiest next move
+    Hint hint = nextHint(board);
+    cout << "Hint: place " << hint.digit << " at (" << hint.row << ", " << hint.col << ") using "
+         << hintTechniqueName(hint.technique) << "\n";
+
     // Test solving the puzzle
     if (solve(board)) {
         cout << "Solved Puzzle:\n";
@@ -60,11 +74,178 @@ int main() {
  * @brief Main function for production use.
  *
  * Generates, solves, and compares Sudoku puzzles.
+ *
+ * Options:
+ * - `--async-io`: read and write puzzle files through the asynchronous backend
+ *   (io_uring when available, a thread pool otherwise).
+ * - `--sharded`: store files in nested shard folders with 8-digit indices
+ *   (e.g. `data/puzzles/00/12/00123456PUZZLE.txt`) instead of one flat folder.
+ * - `--manifest PATH`: cache the list of puzzle files in PATH between runs.
+ * - `--checkpoint PATH`: record solved puzzles in PATH every few seconds.
+ * - `--resume`: skip the puzzles recorded in the checkpoint by a previous run
+ *   (puzzles are then not generated again).
+ * - `--shards N`: generate the puzzles, then solve them with N independent
+ *   SudokuProject processes (one per index range) and print their merged statistics.
+ * - `--shard K/N`: solve only shard K (0 <= K < N) of N and exit (used by `--shards`).
+ * - `--stats-out PATH`: write the solving statistics to PATH.
+ * - `--latency-out PATH`: write the solve latency percentile distribution to PATH
+ *   (HdrHistogram text format, microseconds).
+ * - `--quarantine PATH`: append puzzles whose solve is slower than `--quarantine-ms MS`
+ *   or visits more than `--quarantine-nodes N` search nodes to PATH (100 ms when
+ *   neither threshold is given); replay them with `SudokuBench replay --file PATH`.
+ * - `--minimal`: generate minimal puzzles (unique solution, no removable clue)
+ *   instead of puzzles with a fixed number of empty cells.
+ * - `--unique`: generate puzzles with the usual number of empty cells and a
+ *   unique solution.
+ * - `--symmetry NAME`: make the clue pattern of these puzzles `rotational`
+ *   (180 degrees), `diagonal` or `dihedral` (all rotations and mirrors) symmetric;
+ *   implies `--minimal` unless `--unique` is given.
+ * - `--removal-order NAME`: order of their clue removals, `random` (default) or
+ *   `fewest-alternatives` (fewer failed uniqueness checks); implies `--minimal`
+ *   unless `--unique` is given.
+ * - `--grid-pool DEPTH`: keep DEPTH complete grids ready in a pool refilled by
+ *   background threads (`--grid-pool-workers N`, default 1), so generating a
+ *   puzzle only removes clues.
+ * - `--grid-sampler NAME`: how complete grids are drawn, `diagonal-fill` (default,
+ *   fastest) or `uniform` (every valid grid about equally likely).
+ * - `--trace PATH`: write a Chrome trace (JSON) of the run to PATH; needs a build
+ *   configured with `-DSUDOKU_ENABLE_TRACE=ON`.
  */
-int main() {
+int main(int argc, char** argv) {
+    BatchOptions options;
+    BatchStats stats;
+    options.stats = &stats;
+    unique_ptr<FileIOBackend> io;
+    int num_shards = 1;
+    bool shard_worker = false;
+    string stats_out;
+    string latency_out;
+    string trace_out;
+    vector<string> forwarded; // Options passed on to shard processes
+    bool shaped_puzzles = false; // --symmetry or --removal-order given
+    int grid_pool_depth = 0;
+    int grid_pool_workers = 1;
+    unique_ptr<GridPool> grid_pool;
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        if (arg == "--async-io") {
+            io = createFileIOBackend();
+            options.io = io.get();
+            cout << "Using " << io->name() << " file I/O backend\n";
+            forwarded.push_back(arg);
+        } else if (arg == "--manifest" && i + 1 < argc) {
+            options.manifest_path = argv[++i];
+        } else if (arg == "--checkpoint" && i + 1 < argc) {
+            options.checkpoint_path = argv[++i];
+            forwarded.insert(forwarded.end(), {arg, options.checkpoint_path});
+        } else if (arg == "--resume") {
+            options.resume = true;
+            forwarded.push_back(arg);
+        } else if (arg == "--sharded") {
+            setFileNameLayout(shardedFileNameLayout());
+            forwarded.push_back(arg);
+        } else if (arg == "--shards" && i + 1 < argc) {
+            num_shards = max(1, atoi(argv[++i]));
+        } else if (arg == "--shard" && i + 1 < argc) {
+            if (sscanf(argv[++i], "%d/%d", &options.shard_index, &options.shard_count) != 2 ||
+                options.shard_index < 0 || options.shard_index >= options.shard_count) {
+                cerr << "Usage: --shard K/N with 0 <= K < N, got " << argv[i] << endl;
+                return 1;
+            }
+            shard_worker = true;
+        } else if (arg == "--stats-out" && i + 1 < argc) {
+            stats_out = argv[++i];
+        } else if (arg == "--latency-out" && i + 1 < argc) {
+            latency_out = argv[++i];
+        } else if (arg == "--quarantine" && i + 1 < argc) {
+            options.quarantine_path = argv[++i];
+            forwarded.insert(forwarded.end(), {arg, options.quarantine_path});
+        } else if (arg == "--quarantine-ms" && i + 1 < argc) {
+            options.quarantine_seconds = atof(argv[++i]) / 1000.0;
+            forwarded.insert(forwarded.end(), {arg, argv[i]});
+        } else if (arg == "--quarantine-nodes" && i + 1 < argc) {
+            options.quarantine_nodes = atoll(argv[++i]);
+            forwarded.insert(forwarded.end(), {arg, argv[i]});
+        } else if (arg == "--minimal") {
+            options.minimal_puzzles = true;
+        } else if (arg == "--unique") {
+            options.unique_puzzles = true;
+        } else if (arg == "--symmetry" && i + 1 < argc) {
+            if (!clueSymmetryFromName(argv[++i], options.clue_symmetry)) {
+                cerr << "Unknown symmetry: " << argv[i] << endl;
+                return 1;
+            }
+            shaped_puzzles = true;
+        } else if (arg == "--removal-order" && i + 1 < argc) {
+            if (!removalOrderFromName(argv[++i], options.removal_order)) {
+                cerr << "Unknown removal order: " << argv[i] << endl;
+                return 1;
+            }
+            shaped_puzzles = true;
+        } else if (arg == "--grid-pool" && i + 1 < argc) {
+            grid_pool_depth = max(1, atoi(argv[++i]));
+        } else if (arg == "--grid-pool-workers" && i + 1 < argc) {
+            grid_pool_workers = max(1, atoi(argv[++i]));
+        } else if (arg == "--grid-sampler" && i + 1 < argc) {
+            GridSampler sampler;
+            if (!gridSamplerFromName(argv[++i], sampler)) {
+                cerr << "Unknown grid sampler: " << argv[i] << endl;
+                return 1;
+            }
+            setGridSampler(sampler);
+        } else if (arg == "--trace" && i + 1 < argc) {
+            trace_out = argv[++i];
+            if (!traceCompiledIn()) cerr << "Tracing is compiled out; configure with -DSUDOKU_ENABLE_TRACE=ON" << endl;
+            setTraceThreadName("main");
+            forwarded.insert(forwarded.end(), {arg, trace_out});
+        } else {
+            cerr << "Unknown option: " << arg << endl;
+            return 1;
+        }
+    }
+
+    if (shaped_puzzles && !options.unique_puzzles) options.minimal_puzzles = true;
+    if (grid_pool_depth > 0 && !shard_worker) {
+        grid_pool.reset(new GridPool(grid_pool_depth, grid_pool_workers));
+        setGridPool(grid_pool.get());
+    }
+
+    if (!options.quarantine_path.empty() && options.quarantine_seconds == 0 && options.quarantine_nodes == 0) {
+        options.quarantine_seconds = 0.1;
+    }
+
+    if (shard_worker) {
+        // One process of a sharded run: solve this shard's range only
+        if (!options.checkpoint_path.empty()) options.checkpoint_path += ".shard" + to_string(options.shard_index);
+        solveAndSaveNPuzzles(NUM_PUZZLE_TO_GENERATE, PATH_TO_PUZZLES, PATH_TO_SOLUTIONS, SOLUTION_PREFIX, options);
+        if (!trace_out.empty()) writeChromeTrace(trace_out + ".shard" + to_string(options.shard_index));
+        return stats_out.empty() || saveBatchStats(stats, stats_out) ? 0 : 1;
+    }
+
     initDataFolder();
-    createAndSaveNPuzzles(NUM_PUZZLE_TO_GENERATE, COMPLEXITY_EMPTY_BOXES, PATH_TO_PUZZLES, PUZZLE_PREFIX);
-    solveAndSaveNPuzzles(NUM_PUZZLE_TO_GENERATE, PATH_TO_PUZZLES, PATH_TO_SOLUTIONS, SOLUTION_PREFIX);
+    if (!options.resume) {
+        createAndSaveNPuzzles(NUM_PUZZLE_TO_GENERATE, COMPLEXITY_EMPTY_BOXES, PATH_TO_PUZZLES, PUZZLE_PREFIX, options);
+    }
+
+    if (num_shards > 1) {
+        // Scan the puzzles once; every shard process then reads the cached manifest
+        if (options.manifest_path.empty()) options.manifest_path = "data/puzzles.manifest";
+        loadSudokuManifest(PATH_TO_PUZZLES, options.manifest_path);
+        forwarded.insert(forwarded.end(), {"--manifest", options.manifest_path});
+
+        int failures = runShardedJob(argv[0], num_shards, forwarded, "data/shard_", stats);
+        printBatchReport(stats, "Sharded Run Summary (" + to_string(num_shards) + " shards)");
+        if (!stats_out.empty()) saveBatchStats(stats, stats_out);
+        if (!latency_out.empty()) saveLatencyDistribution(stats, latency_out);
+        if (!trace_out.empty()) writeChromeTrace(trace_out);
+        return failures == 0 ? 0 : 1;
+    }
+
+    solveAndSaveNPuzzles(NUM_PUZZLE_TO_GENERATE, PATH_TO_PUZZLES, PATH_TO_SOLUTIONS, SOLUTION_PREFIX, options);
+    printBatchReport(stats, "Batch Run Summary");
+    if (!stats_out.empty()) saveBatchStats(stats, stats_out);
+    if (!latency_out.empty()) saveLatencyDistribution(stats, latency_out);
+    if (!trace_out.empty()) writeChromeTrace(trace_out);
 
     // Run experiments to compare solvers
     compareSudokuSolvers(10, 64);
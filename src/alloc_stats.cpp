@@ -0,0 +1,169 @@
+/**
+ * @file alloc_stats.cpp
+ * @brief Counting replacements of the global operator new/delete.
+ *
+ * The replacements are only compiled with `SUDOKU_ENABLE_ALLOC_STATS`. They
+ * live in the same translation unit as threadAllocationCounters(), so any
+ * executable reading the counters links them in from the static library.
+ * Both the plain and the `std::align_val_t` (over-aligned types) overloads
+ * are replaced, each with its sized and nothrow forms, so every allocation of
+ * a new-expression is counted.
+ * Detailed function descriptions are provided in the corresponding header file.
+ */
+
+#include "../include/alloc_stats.h"
+#include <algorithm>
+#include <cstdlib>
+#include <new>
+#ifdef _WIN32
+#include <malloc.h>
+#endif
+
+static thread_local AllocationCounters counters;
+
+bool allocationTrackingEnabled() {
+#ifdef SUDOKU_ENABLE_ALLOC_STATS
+    return true;
+#else
+    return false;
+#endif
+}
+
+AllocationCounters threadAllocationCounters() {
+    return counters;
+}
+
+AllocationCounters operator-(const AllocationCounters& after, const AllocationCounters& before) {
+    AllocationCounters difference;
+    difference.allocations = after.allocations - before.allocations;
+    difference.deallocations = after.deallocations - before.deallocations;
+    difference.bytes = after.bytes - before.bytes;
+    return difference;
+}
+
+#ifdef SUDOKU_ENABLE_ALLOC_STATS
+
+static void* countedAllocate(const std::size_t& size) {
+    counters.allocations++;
+    counters.bytes += size;
+    return std::malloc(size == 0 ? 1 : size);
+}
+
+static void countedFree(void* pointer) {
+    if (!pointer) return;
+    counters.deallocations++;
+    std::free(pointer);
+}
+
+static void* countedAllocateAligned(const std::size_t& size, const std::align_val_t& alignment) {
+    counters.allocations++;
+    counters.bytes += size;
+    const std::size_t bytes = size == 0 ? 1 : size;
+#ifdef _WIN32
+    return _aligned_malloc(bytes, static_cast<std::size_t>(alignment));
+#else
+    void* pointer = nullptr;
+    const std::size_t align = std::max(static_cast<std::size_t>(alignment), sizeof(void*));
+    return posix_memalign(&pointer, align, bytes) == 0 ? pointer : nullptr;
+#endif
+}
+
+static void countedFreeAligned(void* pointer) {
+    if (!pointer) return;
+    counters.deallocations++;
+#ifdef _WIN32
+    _aligned_free(pointer); // _aligned_malloc memory cannot go to free()
+#else
+    std::free(pointer);
+#endif
+}
+
+void* operator new(std::size_t size) {
+    void* pointer = countedAllocate(size);
+    if (!pointer) throw std::bad_alloc();
+    return pointer;
+}
+
+void* operator new[](std::size_t size) {
+    void* pointer = countedAllocate(size);
+    if (!pointer) throw std::bad_alloc();
+    return pointer;
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    return countedAllocate(size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    return countedAllocate(size);
+}
+
+void operator delete(void* pointer) noexcept {
+    countedFree(pointer);
+}
+
+void operator delete[](void* pointer) noexcept {
+    countedFree(pointer);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept {
+    countedFree(pointer);
+}
+
+void operator delete[](void* pointer, std::size_t) noexcept {
+    countedFree(pointer);
+}
+
+void operator delete(void* pointer, const std::nothrow_t&) noexcept {
+    countedFree(pointer);
+}
+
+void operator delete[](void* pointer, const std::nothrow_t&) noexcept {
+    countedFree(pointer);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment) {
+    void* pointer = countedAllocateAligned(size, alignment);
+    if (!pointer) throw std::bad_alloc();
+    return pointer;
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment) {
+    void* pointer = countedAllocateAligned(size, alignment);
+    if (!pointer) throw std::bad_alloc();
+    return pointer;
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return countedAllocateAligned(size, alignment);
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return countedAllocateAligned(size, alignment);
+}
+
+void operator delete(void* pointer, std::align_val_t) noexcept {
+    countedFreeAligned(pointer);
+}
+
+void operator delete[](void* pointer, std::align_val_t) noexcept {
+    countedFreeAligned(pointer);
+}
+
+void operator delete(void* pointer, std::size_t, std::align_val_t) noexcept {
+    countedFreeAligned(pointer);
+}
+
+void operator delete[](void* pointer, std::size_t, std::align_val_t) noexcept {
+    countedFreeAligned(pointer);
+}
+
+void operator delete(void* pointer, std::align_val_t, const std::nothrow_t&) noexcept {
+    countedFreeAligned(pointer);
+}
+
+void operator delete[](void* pointer, std::align_val_t, const std::nothrow_t&) noexcept {
+    countedFreeAligned(pointer);
+}
+
+#endif // SUDOKU_ENABLE_ALLOC_STATS
@@ -0,0 +1,401 @@
+/**
+ * @file async_io.cpp
+ * @brief Implementation of the io_uring and thread-pool file I/O backends.
+ *
+ * The io_uring backend talks to the kernel through the raw system calls, so it
+ * needs no extra library. Every request is a chain of three linked operations
+ * (open into a registered file slot, read or write, close) so that opening,
+ * transferring and closing a file costs no syscall of its own; submissions and
+ * completions are batched through the shared rings. The close is hard-linked:
+ * reads are nearly always short, which would cancel a soft-linked close. Detailed descriptions are
+ * provided in the corresponding header file.
+ */
+
+#include "../include/async_io.h"
+#include "../include/trace.h"
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <fstream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#if defined(__linux__) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#ifdef IORING_FILE_INDEX_ALLOC // Direct descriptors for open/close need kernel headers >= 5.15
+#define SUDOKU_HAVE_IO_URING
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+#endif
+#endif
+
+using namespace std;
+
+static bool blockingWrite(const string& path, const string& content) {
+    ofstream outFile(path, ios::binary | ios::trunc);
+    if (!outFile.is_open()) return false;
+    outFile.write(content.data(), static_cast<streamsize>(content.size()));
+    return static_cast<bool>(outFile);
+}
+
+static bool blockingRead(const string& path, string& content) {
+    ifstream inFile(path, ios::binary);
+    if (!inFile.is_open()) return false;
+    content.assign(istreambuf_iterator<char>(inFile), istreambuf_iterator<char>());
+    return true;
+}
+
+// ============================ Thread-pool backend ============================
+
+class ThreadPoolBackend : public FileIOBackend {
+public:
+    ThreadPoolBackend(const unsigned& queueDepth, const unsigned& threads) : depth(max(1u, queueDepth)) {
+        for (unsigned i = 0; i < threads; i++) workers.emplace_back(&ThreadPoolBackend::workerLoop, this);
+    }
+
+    ~ThreadPoolBackend() override {
+        drain();
+        {
+            lock_guard<mutex> guard(lock);
+            stopping = true;
+        }
+        workAvailable.notify_all();
+        for (thread& worker : workers) worker.join();
+    }
+
+    void submitWrite(const string& path, string content, WriteCallback done) override {
+        enqueue([path, content = move(content), done = move(done)]() {
+            SUDOKU_TRACE_SCOPE("io.write");
+            done(blockingWrite(path, content));
+        });
+    }
+
+    void submitRead(const string& path, ReadCallback done) override {
+        enqueue([path, done = move(done)]() {
+            SUDOKU_TRACE_SCOPE("io.read");
+            string content;
+            bool ok = blockingRead(path, content);
+            done(ok, content);
+        });
+    }
+
+    void drain() override {
+        SUDOKU_TRACE_SCOPE("io.drain");
+        unique_lock<mutex> guard(lock);
+        idle.wait(guard, [this]() { return pending == 0; });
+    }
+
+    const char* name() const override { return "thread-pool"; }
+
+private:
+    void enqueue(function<void()> task) {
+        unique_lock<mutex> guard(lock);
+        slotFree.wait(guard, [this]() { return pending < depth; });
+        pending++;
+        tasks.push_back(move(task));
+        guard.unlock();
+        workAvailable.notify_one();
+    }
+
+    void workerLoop() {
+        setTraceThreadName("io-worker");
+        for (;;) {
+            unique_lock<mutex> guard(lock);
+            workAvailable.wait(guard, [this]() { return stopping || !tasks.empty(); });
+            if (tasks.empty()) return;
+            function<void()> task = move(tasks.front());
+            tasks.pop_front();
+            guard.unlock();
+
+            task();
+
+            guard.lock();
+            const bool nowIdle = --pending == 0;
+            guard.unlock();
+            slotFree.notify_one();
+            if (nowIdle) idle.notify_all();
+        }
+    }
+
+    const unsigned depth;
+    unsigned pending = 0; // Queued plus running tasks
+    bool stopping = false;
+    deque<function<void()>> tasks;
+    vector<thread> workers;
+    mutex lock;
+    condition_variable workAvailable;
+    condition_variable slotFree;
+    condition_variable idle;
+};
+
+// ============================== io_uring backend ==============================
+
+#ifdef SUDOKU_HAVE_IO_URING
+
+class UringBackend : public FileIOBackend {
+public:
+    static unique_ptr<UringBackend> create(const unsigned& queueDepth) {
+        unique_ptr<UringBackend> backend(new UringBackend(max(1u, queueDepth)));
+        if (!backend->setup()) return nullptr;
+
+        // Opening into a registered slot is not supported by every kernel, check it once
+        bool works = false;
+        backend->submitRead("/dev/null", [&works](bool ok, string&) { works = ok; });
+        backend->drain();
+        if (!works) return nullptr;
+        return backend;
+    }
+
+    ~UringBackend() override {
+        if (ringFd >= 0) {
+            drain();
+            close(ringFd); // Also closes any file left in a registered slot
+        }
+        if (sqes != MAP_FAILED) munmap(sqes, sqesSize);
+        if (cqRing != MAP_FAILED && cqRing != sqRing) munmap(cqRing, cqRingSize);
+        if (sqRing != MAP_FAILED) munmap(sqRing, sqRingSize);
+    }
+
+    void submitWrite(const string& path, string content, WriteCallback done) override {
+        unsigned slot = acquireSlot();
+        Request& request = requests[slot];
+        request.write = true;
+        request.path = path;
+        request.buffer = move(content);
+        request.onWrite = move(done);
+        queueChain(slot);
+    }
+
+    void submitRead(const string& path, ReadCallback done) override {
+        unsigned slot = acquireSlot();
+        Request& request = requests[slot];
+        request.write = false;
+        request.path = path;
+        request.buffer.resize(READ_BUFFER_SIZE);
+        request.onRead = move(done);
+        queueChain(slot);
+    }
+
+    void drain() override {
+        SUDOKU_TRACE_SCOPE("io.drain");
+        while (inFlight > 0) {
+            enter(1);
+            reap();
+        }
+    }
+
+    const char* name() const override { return "io_uring"; }
+
+private:
+    static const unsigned READ_BUFFER_SIZE = 4096; // Puzzle files are a few hundred bytes
+    static const unsigned SUBMIT_BATCH = 48;       // Operations queued before entering the kernel
+
+    enum Operation { OP_OPEN = 0, OP_TRANSFER = 1, OP_CLOSE = 2 };
+
+    struct Request {
+        bool write = false;
+        string path;
+        string buffer;
+        WriteCallback onWrite;
+        ReadCallback onRead;
+        int results[3] = {0, 0, 0};
+        int completions = 0;
+    };
+
+    explicit UringBackend(const unsigned& queueDepth) : depth(queueDepth), requests(queueDepth) {
+        for (unsigned slot = queueDepth; slot > 0; slot--) freeSlots.push_back(slot - 1);
+    }
+
+    bool setup() {
+        io_uring_params params;
+        memset(&params, 0, sizeof(params));
+        ringFd = static_cast<int>(syscall(__NR_io_uring_setup, depth * 3, &params));
+        if (ringFd < 0) return false;
+
+        sqRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+        cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+        const bool singleMap = params.features & IORING_FEAT_SINGLE_MMAP;
+        if (singleMap) sqRingSize = cqRingSize = max(sqRingSize, cqRingSize);
+
+        sqRing = mmap(nullptr, sqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd, IORING_OFF_SQ_RING);
+        if (sqRing == MAP_FAILED) return false;
+        cqRing = singleMap ? sqRing
+                           : mmap(nullptr, cqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd, IORING_OFF_CQ_RING);
+        if (cqRing == MAP_FAILED) return false;
+        sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+        sqes = mmap(nullptr, sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd, IORING_OFF_SQES);
+        if (sqes == MAP_FAILED) return false;
+
+        char* sq = static_cast<char*>(sqRing);
+        char* cq = static_cast<char*>(cqRing);
+        sqHead = reinterpret_cast<unsigned*>(sq + params.sq_off.head);
+        sqTail = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+        sqMask = *reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+        sqEntries = params.sq_entries;
+        sqArray = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+        cqHead = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+        cqTail = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+        cqMask = *reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+        cqes = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+
+        // One sparse registered file slot per request
+        vector<int> files(depth, -1);
+        return syscall(__NR_io_uring_register, ringFd, IORING_REGISTER_FILES, files.data(), depth) == 0;
+    }
+
+    unsigned acquireSlot() {
+        while (freeSlots.empty()) {
+            enter(1);
+            reap();
+        }
+        unsigned slot = freeSlots.back();
+        freeSlots.pop_back();
+        inFlight++;
+        return slot;
+    }
+
+    io_uring_sqe* nextSqe() {
+        unsigned tail = *sqTail;
+        while (tail - __atomic_load_n(sqHead, __ATOMIC_ACQUIRE) >= sqEntries) enter(0);
+        unsigned index = tail & sqMask;
+        io_uring_sqe* sqe = static_cast<io_uring_sqe*>(sqes) + index;
+        memset(sqe, 0, sizeof(*sqe));
+        sqArray[index] = index;
+        __atomic_store_n(sqTail, tail + 1, __ATOMIC_RELEASE);
+        toSubmit++;
+        return sqe;
+    }
+
+    void queueChain(const unsigned& slot) {
+        Request& request = requests[slot];
+
+        io_uring_sqe* open = nextSqe();
+        open->opcode = IORING_OP_OPENAT;
+        open->fd = AT_FDCWD;
+        open->addr = reinterpret_cast<unsigned long long>(request.path.c_str());
+        open->open_flags = request.write ? O_WRONLY | O_CREAT | O_TRUNC : O_RDONLY;
+        open->len = request.write ? 0644 : 0;
+        open->file_index = slot + 1; // Install as registered file `slot`
+        open->flags = IOSQE_IO_LINK;
+        open->user_data = slot * 4 + OP_OPEN;
+
+        io_uring_sqe* transfer = nextSqe();
+        transfer->opcode = request.write ? IORING_OP_WRITE : IORING_OP_READ;
+        transfer->fd = static_cast<int>(slot);
+        transfer->addr = reinterpret_cast<unsigned long long>(request.buffer.data());
+        transfer->len = static_cast<unsigned>(request.buffer.size());
+        transfer->off = 0;
+        // A short read breaks a soft link and cancels the close; a hard link closes the slot whatever the transfer did
+        transfer->flags = IOSQE_FIXED_FILE | IOSQE_IO_HARDLINK;
+        transfer->user_data = slot * 4 + OP_TRANSFER;
+
+        io_uring_sqe* closing = nextSqe();
+        closing->opcode = IORING_OP_CLOSE;
+        closing->file_index = slot + 1;
+        closing->user_data = slot * 4 + OP_CLOSE;
+
+        if (toSubmit >= SUBMIT_BATCH) enter(0);
+        reap();
+    }
+
+    // Submits queued operations and optionally waits for `minComplete` completions.
+    void enter(const unsigned& minComplete) {
+        for (;;) {
+            long submitted = syscall(__NR_io_uring_enter, ringFd, toSubmit, minComplete,
+                                     minComplete > 0 ? IORING_ENTER_GETEVENTS : 0, nullptr, 0);
+            if (submitted >= 0) {
+                toSubmit -= static_cast<unsigned>(submitted);
+                return;
+            }
+            if (errno == EINTR) continue;
+            if (errno == EAGAIN || errno == EBUSY) {
+                // Completion queue is full: make room and retry
+                reap();
+                continue;
+            }
+            return;
+        }
+    }
+
+    void reap() {
+        unsigned head = *cqHead;
+        const unsigned tail = __atomic_load_n(cqTail, __ATOMIC_ACQUIRE);
+        for (; head != tail; head++) {
+            const io_uring_cqe& cqe = cqes[head & cqMask];
+            const unsigned slot = static_cast<unsigned>(cqe.user_data / 4);
+            Request& request = requests[slot];
+            request.results[cqe.user_data % 4] = cqe.res;
+            if (++request.completions == 3) finish(slot);
+        }
+        __atomic_store_n(cqHead, head, __ATOMIC_RELEASE);
+    }
+
+    void finish(const unsigned& slot) {
+        Request& request = requests[slot];
+        const int transferred = request.results[OP_TRANSFER];
+        bool ok = request.results[OP_OPEN] >= 0 && transferred >= 0 && request.results[OP_CLOSE] >= 0;
+        if (request.write) {
+            ok = ok && static_cast<size_t>(transferred) == request.buffer.size();
+            request.onWrite(ok);
+        } else {
+            if (ok && static_cast<unsigned>(transferred) == READ_BUFFER_SIZE) {
+                ok = blockingRead(request.path, request.buffer); // Larger than the buffer, read it whole
+            } else if (ok) {
+                request.buffer.resize(static_cast<size_t>(transferred));
+            }
+            request.onRead(ok, request.buffer);
+        }
+
+        request.path.clear();
+        request.buffer.clear();
+        request.onWrite = nullptr;
+        request.onRead = nullptr;
+        request.completions = 0;
+        freeSlots.push_back(slot);
+        inFlight--;
+    }
+
+    const unsigned depth;
+    vector<Request> requests;
+    vector<unsigned> freeSlots;
+    unsigned inFlight = 0;
+    unsigned toSubmit = 0;
+
+    int ringFd = -1;
+    void* sqRing = MAP_FAILED;
+    void* cqRing = MAP_FAILED;
+    void* sqes = MAP_FAILED;
+    size_t sqRingSize = 0;
+    size_t cqRingSize = 0;
+    size_t sqesSize = 0;
+    unsigned* sqHead = nullptr;
+    unsigned* sqTail = nullptr;
+    unsigned* sqArray = nullptr;
+    unsigned sqMask = 0;
+    unsigned sqEntries = 0;
+    unsigned* cqHead = nullptr;
+    unsigned* cqTail = nullptr;
+    unsigned cqMask = 0;
+    io_uring_cqe* cqes = nullptr;
+};
+
+#endif // SUDOKU_HAVE_IO_URING
+
+unique_ptr<FileIOBackend> createFileIOBackend(const unsigned& queueDepth, const bool& preferUring) {
+#ifdef SUDOKU_HAVE_IO_URING
+    if (preferUring) {
+        unique_ptr<UringBackend> uring = UringBackend::create(queueDepth);
+        if (uring) return uring;
+    }
+#endif
+    (void)preferUring;
+    const unsigned threads = min(max(1u, queueDepth), max(4u, 2 * thread::hardware_concurrency()));
+    return unique_ptr<FileIOBackend>(new ThreadPoolBackend(queueDepth, threads));
+}
@@ -0,0 +1,157 @@
+/**
+ * @file batch_stats.cpp
+ * @brief Implementation of batch statistics, their file format and merging.
+ *
+ * The file format is one `key value...` pair per line so that shard outputs
+ * stay readable and diffable. Detailed function descriptions are provided in
+ * the corresponding header file.
+ */
+
+#include "../include/batch_stats.h"
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+using namespace std;
+
+static const char* const STATS_HEADER = "# sudoku batch stats v2";
+
+static void mergeAllocations(AllocationCounters& into, const AllocationCounters& from) {
+    into.allocations += from.allocations;
+    into.deallocations += from.deallocations;
+    into.bytes += from.bytes;
+}
+
+static void printAllocations(const char* stage, const AllocationCounters& counters, const long long& operations) {
+    const double divisor = static_cast<double>(max(1LL, operations));
+    cout << stage << " " << setprecision(1) << counters.allocations / divisor << " allocs, "
+         << counters.bytes / divisor << " bytes";
+}
+
+void recordSolveLatency(BatchStats& stats, const double& seconds) {
+    stats.latency.recordSeconds(seconds);
+    stats.solve_seconds += seconds;
+}
+
+double latencyPercentile(const BatchStats& stats, const double& percentile) {
+    return stats.latency.valueAtPercentile(percentile) / 1000.0;
+}
+
+void mergeBatchStats(BatchStats& into, const BatchStats& from) {
+    into.loaded += from.loaded;
+    into.solved += from.solved;
+    into.written += from.written;
+    into.skipped += from.skipped;
+    into.quarantined += from.quarantined;
+    into.solve_seconds += from.solve_seconds;
+    into.wall_seconds = max(into.wall_seconds, from.wall_seconds);
+    into.latency.merge(from.latency);
+    mergeAllocations(into.parse_allocations, from.parse_allocations);
+    mergeAllocations(into.solve_allocations, from.solve_allocations);
+    mergeAllocations(into.write_allocations, from.write_allocations);
+}
+
+bool saveBatchStats(const BatchStats& stats, const string& filename) {
+    const string temporary = filename + ".tmp";
+    {
+        ofstream out(temporary, ios::trunc);
+        if (!out.is_open()) return false;
+        out << STATS_HEADER << "\n";
+        out << "loaded " << stats.loaded << "\n";
+        out << "solved " << stats.solved << "\n";
+        out << "written " << stats.written << "\n";
+        out << "skipped " << stats.skipped << "\n";
+        out << "quarantined " << stats.quarantined << "\n";
+        out << setprecision(17) << "solve_seconds " << stats.solve_seconds << "\n";
+        out << "wall_seconds " << stats.wall_seconds << "\n";
+        out << "latency_ns " << stats.latency.serialize() << "\n";
+        const AllocationCounters* stages[] = {&stats.parse_allocations, &stats.solve_allocations, &stats.write_allocations};
+        const char* names[] = {"parse_allocs ", "solve_allocs ", "write_allocs "};
+        for (int i = 0; i < 3; i++) {
+            out << names[i] << stages[i]->allocations << " " << stages[i]->deallocations << " " << stages[i]->bytes << "\n";
+        }
+        if (!out) return false;
+    }
+    // rename replaces the old file atomically, so a reader (e.g. the shard merge) always finds a complete file
+    error_code error;
+    filesystem::rename(temporary, filename, error);
+#ifdef _WIN32
+    if (error) {
+        // Windows refuses to replace a file that is open elsewhere; fall back to remove and retry
+        remove(filename.c_str());
+        filesystem::rename(temporary, filename, error);
+    }
+#endif
+    return !error;
+}
+
+bool loadBatchStats(BatchStats& stats, const string& filename) {
+    ifstream in(filename);
+    string line;
+    if (!getline(in, line) || line != STATS_HEADER) return false;
+
+    stats = BatchStats();
+    while (getline(in, line)) {
+        istringstream fields(line);
+        string key;
+        fields >> key;
+        if (key == "loaded") fields >> stats.loaded;
+        else if (key == "solved") fields >> stats.solved;
+        else if (key == "written") fields >> stats.written;
+        else if (key == "skipped") fields >> stats.skipped;
+        else if (key == "quarantined") fields >> stats.quarantined;
+        else if (key == "solve_seconds") fields >> stats.solve_seconds;
+        else if (key == "wall_seconds") fields >> stats.wall_seconds;
+        else if (key == "parse_allocs" || key == "solve_allocs" || key == "write_allocs") {
+            AllocationCounters& counters = key[0] == 'p' ? stats.parse_allocations
+                                         : key[0] == 's' ? stats.solve_allocations : stats.write_allocations;
+            fields >> counters.allocations >> counters.deallocations >> counters.bytes;
+        }
+        else if (key == "latency_ns") {
+            string buckets;
+            getline(fields, buckets);
+            if (!stats.latency.deserialize(buckets)) return false;
+            continue;
+        }
+        if (fields.fail()) return false;
+    }
+    return true;
+}
+
+bool saveLatencyDistribution(const BatchStats& stats, const string& filename) {
+    ofstream out(filename, ios::trunc);
+    if (!out.is_open()) return false;
+    stats.latency.outputPercentileDistribution(out);
+    return static_cast<bool>(out);
+}
+
+void printBatchReport(const BatchStats& stats, const string& title) {
+    // The report switches cout to fixed notation; give the caller its formatting back at the end
+    const ios::fmtflags flags = cout.flags();
+    const streamsize precision = cout.precision();
+    cout << "====================== " << title << " ======================" << endl;
+    cout << "Puzzles loaded: " << stats.loaded << " | solved: " << stats.solved
+         << " | written: " << stats.written << " | skipped: " << stats.skipped
+         << " | quarantined: " << stats.quarantined << endl;
+    cout << fixed << setprecision(3);
+    cout << "Wall time: " << stats.wall_seconds << " s | solve time: " << stats.solve_seconds << " s";
+    if (stats.wall_seconds > 0) cout << " | throughput: " << setprecision(1) << stats.solved / stats.wall_seconds << " puzzles/s";
+    cout << endl;
+    cout << setprecision(1) << "Solve latency (us): p50 " << latencyPercentile(stats, 50)
+         << " | p90 " << latencyPercentile(stats, 90) << " | p99 " << latencyPercentile(stats, 99)
+         << " | p99.9 " << latencyPercentile(stats, 99.9) << " | p99.99 " << latencyPercentile(stats, 99.99)
+         << " | max " << stats.latency.max() / 1000.0 << endl;
+    if (allocationTrackingEnabled()) {
+        printAllocations("Heap per parse:", stats.parse_allocations, stats.loaded);
+        printAllocations(" | per solve:", stats.solve_allocations, stats.loaded);
+        printAllocations(" | per write:", stats.write_allocations, stats.solved);
+        cout << endl;
+    }
+    cout << "===========================================================================" << endl;
+    cout.flags(flags);
+    cout.precision(precision);
+}
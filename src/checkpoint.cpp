@@ -0,0 +1,113 @@
+/**
+ * @file checkpoint.cpp
+ * @brief Implementation of the batch completion bitmap.
+ *
+ * File format: the 8-byte magic "SDKCKPT1", the number of tracked indices and
+ * the number of completed ones (both 64-bit), then the bitmap as 64-bit words.
+ * Detailed function descriptions are provided in the corresponding header file.
+ */
+
+#include "../include/checkpoint.h"
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+static const char CHECKPOINT_MAGIC[8] = {'S', 'D', 'K', 'C', 'K', 'P', 'T', '1'};
+
+BatchCheckpoint::BatchCheckpoint(const string& path, const size_t& size, const double& intervalSeconds)
+    : path(path), size(size), wordCount((size + 63) / 64), words(new atomic<unsigned long long>[(size + 63) / 64]),
+      doneCount(0),
+      interval(chrono::duration_cast<chrono::steady_clock::duration>(chrono::duration<double>(intervalSeconds))),
+      nextSave((chrono::steady_clock::now() + interval).time_since_epoch().count()) {
+    for (size_t i = 0; i < wordCount; i++) words[i].store(0, memory_order_relaxed);
+}
+
+bool BatchCheckpoint::load() {
+    FILE* file = fopen(path.c_str(), "rb");
+    if (!file) return false;
+
+    // Puzzle indices are stable, so a checkpoint of another size still applies to the indices both track
+    char magic[8];
+    unsigned long long header[2];
+    vector<unsigned long long> bitmap;
+    bool ok = fread(magic, 1, sizeof(magic), file) == sizeof(magic)
+              && memcmp(magic, CHECKPOINT_MAGIC, sizeof(magic)) == 0
+              && fread(header, sizeof(header[0]), 2, file) == 2;
+    // Trust the stored size only if the file really holds that many words, so a corrupt header cannot allocate
+    const unsigned long long storedWords = header[0] / 64 + (header[0] % 64 != 0);
+    error_code error;
+    const unsigned long long fileSize = filesystem::file_size(path, error);
+    ok = ok && !error && fileSize >= sizeof(magic) + sizeof(header)
+         && (fileSize - sizeof(magic) - sizeof(header)) / sizeof(unsigned long long) == storedWords
+         && (fileSize - sizeof(magic) - sizeof(header)) % sizeof(unsigned long long) == 0;
+    if (ok) {
+        bitmap.resize(storedWords);
+        ok = fread(bitmap.data(), sizeof(unsigned long long), bitmap.size(), file) == bitmap.size();
+    }
+    fclose(file);
+    if (!ok) return false;
+
+    bitmap.resize(wordCount, 0);
+    if (size % 64) bitmap[wordCount - 1] &= (1ull << (size % 64)) - 1; // Drop indices past the end
+    size_t count = 0;
+    for (size_t i = 0; i < wordCount; i++) {
+        words[i].store(bitmap[i], memory_order_relaxed);
+        for (unsigned long long word = bitmap[i]; word; word &= word - 1) count++;
+    }
+    doneCount.store(count);
+    return true;
+}
+
+bool BatchCheckpoint::save() {
+    lock_guard<mutex> guard(saving);
+    vector<unsigned long long> bitmap(wordCount);
+    for (size_t i = 0; i < wordCount; i++) bitmap[i] = words[i].load(memory_order_relaxed);
+    const unsigned long long header[2] = {size, doneCount.load()};
+
+    const string temporary = path + ".tmp";
+    FILE* file = fopen(temporary.c_str(), "wb");
+    if (!file) return false;
+    bool ok = fwrite(CHECKPOINT_MAGIC, 1, sizeof(CHECKPOINT_MAGIC), file) == sizeof(CHECKPOINT_MAGIC)
+              && fwrite(header, sizeof(header[0]), 2, file) == 2
+              && fwrite(bitmap.data(), sizeof(unsigned long long), wordCount, file) == wordCount
+              && fflush(file) == 0;
+#if defined(__unix__) || defined(__APPLE__)
+    ok = ok && fsync(fileno(file)) == 0; // The data must be on disk before the rename is
+#endif
+    ok = fclose(file) == 0 && ok;
+    if (!ok) return false;
+
+    error_code error;
+    filesystem::rename(temporary, path, error);
+    return !error;
+}
+
+bool BatchCheckpoint::isDone(const size_t& index) const {
+    if (index >= size) return false;
+    return (words[index / 64].load(memory_order_relaxed) >> (index % 64)) & 1;
+}
+
+void BatchCheckpoint::markDone(const size_t& index) {
+    if (index >= size) return;
+    const unsigned long long bit = 1ull << (index % 64);
+    if (!(words[index / 64].fetch_or(bit, memory_order_relaxed) & bit)) doneCount++;
+
+    const long long now = chrono::steady_clock::now().time_since_epoch().count();
+    if (now < nextSave.load(memory_order_relaxed)) return;
+    unique_lock<mutex> guard(saving, try_to_lock);
+    if (!guard.owns_lock()) return; // Another thread is saving
+    nextSave.store(now + interval.count(), memory_order_relaxed);
+    guard.unlock();
+    save();
+}
+
+size_t BatchCheckpoint::completed() const {
+    return doneCount.load();
+}
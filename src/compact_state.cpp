@@ -0,0 +1,48 @@
+/**
+ * @file compact_state.cpp
+ * @brief Conversions between CompactSudokuState and the other board representations.
+ *
+ * Detailed function descriptions are provided in the corresponding header file.
+ */
+
+#include "../include/compact_state.h"
+#include "../include/sudoku_tables.h"
+
+bool loadCompactState(const unsigned char* cells, CompactSudokuState& state) {
+    for (int i = 0; i < 9; i++) state.row_used[i] = state.col_used[i] = state.box_used[i] = 0;
+    for (int i = 0; i < 41; i++) state.cells[i] = 0;
+    state.empty_count = 0;
+
+    for (int cell = 0; cell < SUDOKU_CELLS; cell++) {
+        const int k = cells[cell];
+        if (k == 0) {
+            state.empty[state.empty_count++] = static_cast<unsigned char>(cell);
+            continue;
+        }
+        if (k > 9) return false;
+        const unsigned short bit = static_cast<unsigned short>(1 << (k - 1));
+        const int r = SUDOKU_TABLES.row_of[cell], c = SUDOKU_TABLES.col_of[cell], b = SUDOKU_TABLES.box_of[cell];
+        if ((state.row_used[r] | state.col_used[c] | state.box_used[b]) & bit) return false;
+        state.row_used[r] |= bit;
+        state.col_used[c] |= bit;
+        state.box_used[b] |= bit;
+        setCompactCell(state, cell, k);
+    }
+    return true;
+}
+
+bool loadCompactState(int** BOARD, CompactSudokuState& state) {
+    unsigned char cells[SUDOKU_CELLS];
+    for (int cell = 0; cell < SUDOKU_CELLS; cell++) {
+        const int k = BOARD[SUDOKU_TABLES.row_of[cell]][SUDOKU_TABLES.col_of[cell]];
+        if (k < 0 || k > 9) return false;
+        cells[cell] = static_cast<unsigned char>(k);
+    }
+    return loadCompactState(cells, state);
+}
+
+void storeCompactState(const CompactSudokuState& state, int** BOARD) {
+    for (int cell = 0; cell < SUDOKU_CELLS; cell++) {
+        BOARD[SUDOKU_TABLES.row_of[cell]][SUDOKU_TABLES.col_of[cell]] = compactCell(state, cell);
+    }
+}
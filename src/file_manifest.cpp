@@ -0,0 +1,204 @@
+/**
+ * @file file_manifest.cpp
+ * @brief Implementation of the concurrent folder scanner and manifest cache.
+ *
+ * The scanner keeps a shared stack of folders still to list. Each worker pops
+ * a folder, lists it (non-recursively), pushes the sub-folders it found and
+ * keeps the files in a private vector, so threads only synchronize once per
+ * folder. Detailed function descriptions are provided in the corresponding
+ * header file.
+ */
+
+#include "../include/file_manifest.h"
+#include <algorithm>
+#include <cctype>
+#include <climits>
+#include <condition_variable>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <sstream>
+#include <thread>
+
+using namespace std;
+
+namespace {
+
+const char* const MANIFEST_HEADER = "# sudoku manifest v1";
+
+struct FolderStamp {
+    string path;
+    long long modified;
+};
+
+long long modificationTime(const filesystem::path& folder) {
+    error_code error;
+    auto time = filesystem::last_write_time(folder, error);
+    return error ? LLONG_MIN : static_cast<long long>(time.time_since_epoch().count());
+}
+
+class FolderScan {
+public:
+    FolderScan(const string& root, const unsigned& threads) {
+        pending.push_back(filesystem::path(root));
+        unsigned count = threads ? threads : max(1u, thread::hardware_concurrency());
+        vector<thread> workers;
+        for (unsigned t = 1; t < count; t++) workers.emplace_back(&FolderScan::work, this);
+        work();
+        for (thread& worker : workers) worker.join();
+    }
+
+    vector<ManifestEntry> files;
+    vector<FolderStamp> folders;
+
+private:
+    void work() {
+        vector<ManifestEntry> localFiles;
+        vector<FolderStamp> localFolders;
+        vector<filesystem::path> found;
+        unique_lock<mutex> guard(lock);
+        for (;;) {
+            ready.wait(guard, [this]() { return !pending.empty() || active == 0; });
+            if (pending.empty()) break;
+            filesystem::path folder = move(pending.back());
+            pending.pop_back();
+            active++;
+            guard.unlock();
+
+            localFolders.push_back({folder.string(), modificationTime(folder)});
+            error_code error;
+            filesystem::directory_iterator iterator(folder, error), end;
+            for (; !error && iterator != end; iterator.increment(error)) {
+                if (iterator->is_directory(error)) {
+                    found.push_back(iterator->path());
+                } else if (iterator->is_regular_file(error)) {
+                    string path = iterator->path().string();
+                    long long index = extractFileIndex(path);
+                    localFiles.push_back({index, move(path)});
+                }
+            }
+
+            guard.lock();
+            active--;
+            pending.insert(pending.end(), make_move_iterator(found.begin()), make_move_iterator(found.end()));
+            if (!found.empty() || (pending.empty() && active == 0)) ready.notify_all();
+            found.clear();
+        }
+        files.insert(files.end(), make_move_iterator(localFiles.begin()), make_move_iterator(localFiles.end()));
+        folders.insert(folders.end(), make_move_iterator(localFolders.begin()), make_move_iterator(localFolders.end()));
+    }
+
+    vector<filesystem::path> pending;
+    int active = 0; // Workers currently listing a folder
+    mutex lock;
+    condition_variable ready;
+};
+
+void sortManifest(vector<ManifestEntry>& entries) {
+    sort(entries.begin(), entries.end(), [](const ManifestEntry& a, const ManifestEntry& b) {
+        // Files without an index go last
+        const long long ia = a.index < 0 ? LLONG_MAX : a.index;
+        const long long ib = b.index < 0 ? LLONG_MAX : b.index;
+        if (ia != ib) return ia < ib;
+        return naturalLess(a.path, b.path);
+    });
+}
+
+bool readManifest(const string& manifestPath, const string& folderPath, vector<ManifestEntry>& entries) {
+    ifstream in(manifestPath);
+    string line;
+    if (!getline(in, line) || line != MANIFEST_HEADER) return false;
+    if (!getline(in, line) || line != "root " + folderPath) return false;
+
+    while (getline(in, line)) {
+        istringstream fields(line);
+        string kind;
+        long long value;
+        fields >> kind >> value;
+        fields.get(); // Separator before the path
+        string path;
+        getline(fields, path);
+        if (kind == "folder") {
+            if (modificationTime(path) != value) return false; // A file was added or removed here
+        } else if (kind == "file") {
+            entries.push_back({value, path});
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
+void writeManifest(const string& manifestPath, const string& folderPath, const vector<FolderStamp>& folders,
+                   const vector<ManifestEntry>& entries) {
+    const string temporary = manifestPath + ".tmp";
+    {
+        ofstream out(temporary, ios::trunc);
+        if (!out.is_open()) return;
+        out << MANIFEST_HEADER << "\n" << "root " << folderPath << "\n";
+        for (const FolderStamp& folder : folders) out << "folder " << folder.modified << " " << folder.path << "\n";
+        for (const ManifestEntry& entry : entries) out << "file " << entry.index << " " << entry.path << "\n";
+        if (!out) return;
+    }
+    rename(temporary.c_str(), manifestPath.c_str());
+}
+
+} // namespace
+
+long long extractFileIndex(const string& path) {
+    size_t start = path.find_last_of("/\\");
+    start = start == string::npos ? 0 : start + 1;
+    while (start < path.size() && !isdigit(static_cast<unsigned char>(path[start]))) start++;
+    if (start == path.size()) return -1;
+
+    long long index = 0;
+    for (size_t i = start; i < path.size() && isdigit(static_cast<unsigned char>(path[i])); i++) {
+        if (index > (LLONG_MAX - 9) / 10) return -1; // Not an index, too many digits
+        index = index * 10 + (path[i] - '0');
+    }
+    return index;
+}
+
+bool naturalLess(const string& a, const string& b) {
+    size_t i = 0, j = 0;
+    while (i < a.size() && j < b.size()) {
+        const bool digitA = isdigit(static_cast<unsigned char>(a[i]));
+        const bool digitB = isdigit(static_cast<unsigned char>(b[j]));
+        if (digitA && digitB) {
+            // Compare the numbers: skip leading zeros, then the longer one is larger
+            size_t endA = i, endB = j;
+            while (i < a.size() && a[i] == '0') i++;
+            while (j < b.size() && b[j] == '0') j++;
+            for (endA = i; endA < a.size() && isdigit(static_cast<unsigned char>(a[endA])); endA++) {}
+            for (endB = j; endB < b.size() && isdigit(static_cast<unsigned char>(b[endB])); endB++) {}
+            if (endA - i != endB - j) return endA - i < endB - j;
+            for (; i < endA; i++, j++) {
+                if (a[i] != b[j]) return a[i] < b[j];
+            }
+        } else {
+            if (a[i] != b[j]) return a[i] < b[j];
+            i++;
+            j++;
+        }
+    }
+    return a.size() - i < b.size() - j;
+}
+
+vector<ManifestEntry> scanSudokuFolder(const string& folderPath, const unsigned& threads) {
+    FolderScan scan(folderPath, threads);
+    sortManifest(scan.files);
+    return move(scan.files);
+}
+
+vector<ManifestEntry> loadSudokuManifest(const string& folderPath, const string& manifestPath) {
+    if (manifestPath.empty()) return scanSudokuFolder(folderPath);
+
+    vector<ManifestEntry> entries;
+    if (readManifest(manifestPath, folderPath, entries)) return entries;
+
+    FolderScan scan(folderPath, 0);
+    sortManifest(scan.files);
+    writeManifest(manifestPath, folderPath, scan.folders, scan.files);
+    return move(scan.files);
+}
@@ -25,13 +25,40 @@
 
 
 #include "../include/generator.h"
+#include "../include/clue_symmetry.h"
+#include "../include/compact_state.h"
+#include "../include/grid_pool.h"
+#include "../include/puzzle_parser.h"
 #include "../include/sudoku.h"
 #include "../include/sudoku_io.h"
+#include "../include/sudoku_tables.h"
+#include "../include/trace.h"
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <cmath>
 #include <random>
 #include <bitset>
 
 using namespace std;
 
+// Random engine of the calling thread, seeded from std::random_device unless setGeneratorSeed() was called
+static mt19937& generatorEngine() {
+    static thread_local mt19937 engine(random_device{}());
+    return engine;
+}
+
+void setGeneratorSeed(const unsigned int& seed) {
+    generatorEngine().seed(seed);
+}
+
+// Clue removals tested by the minimizer on this thread (see getRemovalCounters())
+static thread_local RemovalCounters removalCounters;
+
+RemovalCounters getRemovalCounters() {
+    return removalCounters;
+}
+
 int** getEmptyBoard() {
     int** board = new int*[9];
     for(int i = 0; i < 9; i++){
@@ -43,20 +70,9 @@ int** getEmptyBoard() {
 // Hint 1:  Implement a function to return shuffled vectors
 // Function to return a randomly shuffled vector from 1 to 9
 std::vector<int> getShuffledVector() {
-    // TODO: Implement shuffling logic here
-    /**
-     * TODO:
-     * - Create a vector with numbers 1 to 9.
-     * - Apply a shuffling algorithm to randomize the order.
-     * - Return the shuffled vector.
-     *
-     * Example Output: {3, 1, 4, 2, 7, 6, 5, 9, 8}
-     *
-     * @return std::vector<int> Shuffled numbers from 1 to 9.
-     */
-    // Dummy implementation:
-    // Temporary static return for testing
-    return {3, 1, 4, 2, 7, 6, 5, 9, 8};
+    vector<int> digits = {1, 2, 3, 4, 5, 6, 7, 8, 9};
+    shuffle(digits.begin(), digits.end(), generatorEngine());
+    return digits;
 }
 
 
@@ -114,36 +130,12 @@ std::vector<int> getShuffledVector() {
             */
 
 void fillBoardWithIndependentBox(int** BOARD) {
-    // TODO: Implement logic to fill diagonal 3x3 boxes
-    /**
-     * TODO:
-     * - Iterate over the three diagonal 3x3 boxes.
-     * - Fill each box with unique numbers from 1 to 9.
-     * - Use a shuffled vector for randomization.
-     *
-     * Example Pattern:
-     * - Top-Left, Center, and Bottom-Right boxes should be filled.
-     * - Remaining cells should remain empty.
-     */
-
-    // Dummy implementation:
-    // Temporary static fill based on the provided example
-    int staticBoard[9][9] = {
-        {1, 5, 6, 0, 0, 0, 0, 0, 0},
-        {2, 4, 7, 0, 0, 0, 0, 0, 0},
-        {8, 3, 9, 0, 0, 0, 0, 0, 0},
-        {0, 0, 0, 1, 7, 4, 0, 0, 0},
-        {0, 0, 0, 6, 2, 8, 0, 0, 0},
-        {0, 0, 0, 5, 9, 3, 0, 0, 0},
-        {0, 0, 0, 0, 0, 0, 1, 6, 7},
-        {0, 0, 0, 0, 0, 0, 2, 5, 8},
-        {0, 0, 0, 0, 0, 0, 3, 4, 9}
-    };
-    // Dummy implementation:
-    // Copy static board to the provided BOARD
-    for (int i = 0; i < 9; i++) {
-        for (int j = 0; j < 9; j++) {
-            BOARD[i][j] = staticBoard[i][j];
+    // Boxes 0, 4 and 8 (units 18, 22 and 26) share no row or column, so any fill of them is consistent
+    for (int box = 0; box < 9; box += 4) {
+        const vector<int> digits = getShuffledVector();
+        for (int i = 0; i < 9; i++) {
+            const int cell = SUDOKU_TABLES.unit_cells[18 + box][i];
+            BOARD[SUDOKU_TABLES.row_of[cell]][SUDOKU_TABLES.col_of[cell]] = digits[i];
         }
     }
 }
@@ -192,27 +184,18 @@ void fillBoardWithIndependentBox(int** BOARD) {
 
 // Function to randomly delete 'n' items from a 9x9 Sudoku board using bitsets
 void deleteRandomItems(int** BOARD, const int& n) {
-    // TODO: Implement logic to delete 'n' random cells from the board
-    /**
-     * TODO:
-     * - Validate inputs (e.g., non-null board, valid 'n' between 1 and 81).
-     * - Randomly select 'n' unique cells from the board.
-     * - Replace selected cells with 0.
-     * - Ensure cells aren't deleted more than once.
-     *
-     * Example Behavior:
-     * - For n = 5, randomly select 5 filled cells and set them to 0.
-     * - Ensure the board remains solvable after deletion (optional enhancement).
-     *
-     * @param BOARD A 9x9 Sudoku board.
-     * @param n The number of cells to delete (should be between 1 and 81).
-     */
-
-    // Dummy implementation: Set the first 3 rows to 0
-    for (int r = 0; r < 3; r++) {
-        for (int c = 0; c < 9; c++) {
-            BOARD[r][c] = 0;
-        }
+    if (BOARD == nullptr || n <= 0) return;
+    const int count = min(n, SUDOKU_CELLS);
+
+    // Floyd's algorithm: one random draw per deleted cell and no retries. After the step for j, `chosen`
+    // is a uniform random subset of size j - (81 - count) + 1 of the cells 0..j.
+    bitset<SUDOKU_CELLS> chosen;
+    mt19937& engine = generatorEngine();
+    for (int j = SUDOKU_CELLS - count; j < SUDOKU_CELLS; j++) {
+        const int t = uniform_int_distribution<int>(0, j)(engine);
+        const int cell = chosen[t] ? j : t;
+        chosen[cell] = true;
+        BOARD[SUDOKU_TABLES.row_of[cell]][SUDOKU_TABLES.col_of[cell]] = 0;
     }
 }
 
@@ -220,36 +203,303 @@ void deleteRandomItems(int** BOARD, const int& n) {
 // Finally return the board
 // Note you need add these function prototypes in generator.h files as well
 
+// Full grid of the original generator: shuffled diagonal boxes completed by the (deterministic) solver
+static void generateDiagonalFillGrid(unsigned char* cells) {
+    // Same steps as fillBoardWithIndependentBox() and solve(), on the compact state instead of an int** board
+    fill(cells, cells + SUDOKU_CELLS, 0);
+    for (int box = 0; box < 9; box += 4) {
+        const vector<int> digits = getShuffledVector();
+        for (int i = 0; i < 9; i++) cells[SUDOKU_TABLES.unit_cells[18 + box][i]] = static_cast<unsigned char>(digits[i]);
+    }
+    // The diagonal boxes always extend to a full grid; solveCompact() skips the node limit of solve()
+    CompactSudokuState state;
+    loadCompactState(cells, state);
+    solveCompact(state);
+    for (int cell = 0; cell < SUDOKU_CELLS; cell++) cells[cell] = static_cast<unsigned char>(compactCell(state, cell));
+}
+
+// log(n) for the candidate counts 0-9 (entry 0 is never used in a weight)
+static const double LOG_COUNT[10] = {0.0, 0.0, log(2.0), log(3.0), log(4.0), log(5.0), log(6.0), log(7.0), log(8.0), log(9.0)};
+
+// One attempt of the weighted proposal, see sampleWeightedGrid(). Gives up, returning `false`, on a dead end or
+// as soon as the final log weight can no longer reach `threshold`: the candidate count of a cell only shrinks
+// as the grid fills, so the current counts of the empty cells bound the rest of the weight.
+static bool sampleGridAttempt(unsigned char* cells, double& log_weight, const double& threshold) {
+    unsigned short row_used[9] = {0}, col_used[9] = {0}, box_used[9] = {0};
+    fill(cells, cells + SUDOKU_CELLS, 0);
+    mt19937& engine = generatorEngine();
+    log_weight = 0;
+
+    for (int placed = 0; placed < SUDOKU_CELLS; placed++) {
+        // The cell with the fewest candidates, lowest index first: the choice depends on the filled cells only
+        int best = -1, best_count = 10;
+        unsigned short best_free = 0;
+        double bound = log_weight;
+        for (int cell = 0; cell < SUDOKU_CELLS; cell++) {
+            if (cells[cell] != 0) continue;
+            const unsigned short free = ~(row_used[SUDOKU_TABLES.row_of[cell]] | col_used[SUDOKU_TABLES.col_of[cell]] |
+                                          box_used[SUDOKU_TABLES.box_of[cell]]) & 0x1FF;
+            const int count = countMaskBits(free);
+            if (count == 0) return false; // Dead end
+            bound += LOG_COUNT[count];
+            if (count < best_count) {
+                best = cell;
+                best_count = count;
+                best_free = free;
+            }
+        }
+        if (bound < threshold) return false;
+
+        unsigned short mask = best_free;
+        for (int k = uniform_int_distribution<int>(0, best_count - 1)(engine); k > 0; k--) mask &= mask - 1;
+        const unsigned short bit = mask & -mask;
+        row_used[SUDOKU_TABLES.row_of[best]] |= bit;
+        col_used[SUDOKU_TABLES.col_of[best]] |= bit;
+        box_used[SUDOKU_TABLES.box_of[best]] |= bit;
+        cells[best] = static_cast<unsigned char>(lowestMaskBit(bit) + 1);
+        log_weight += LOG_COUNT[best_count];
+    }
+    return true;
+}
+
+bool sampleWeightedGrid(unsigned char* cells, double& log_weight) {
+    return sampleGridAttempt(cells, log_weight, -1.0);
+}
+
+void generateUniformGrid(unsigned char* cells, const double& log_weight_cap) {
+    SUDOKU_TRACE_SCOPE("generateUniformGrid");
+
+    // Rejection: keep a grid of weight w with probability min(1, w / W), i.e. when log w >= log W + log u.
+    // The proposal returns a grid with probability proportional to 1 / w, so the kept grids are uniform
+    // among those with w <= W.
+    mt19937& engine = generatorEngine();
+    double log_weight = 0;
+    for (;;) {
+        const double u = 1.0 - uniform_real_distribution<double>(0.0, 1.0)(engine); // (0, 1]
+        if (sampleGridAttempt(cells, log_weight, log_weight_cap + log(u))) return;
+    }
+}
+
+// Sampler used by generateFullGrid(), see setGridSampler()
+static atomic<int> selectedGridSampler(GRID_SAMPLER_DIAGONAL_FILL);
+
+void setGridSampler(const GridSampler& sampler) {
+    selectedGridSampler.store(sampler, memory_order_relaxed);
+}
+
+GridSampler getGridSampler() {
+    return static_cast<GridSampler>(selectedGridSampler.load(memory_order_relaxed));
+}
+
+void generateFullGrid(unsigned char* cells) {
+    SUDOKU_TRACE_SCOPE("generateFullGrid");
+
+    if (getGridSampler() == GRID_SAMPLER_UNIFORM) generateUniformGrid(cells);
+    else generateDiagonalFillGrid(cells);
+}
+
+// Pool installed with setGridPool(), or nullptr
+static atomic<GridPool*> installedGridPool(nullptr);
+
+void setGridPool(GridPool* pool) {
+    installedGridPool.store(pool, memory_order_release);
+}
+
+// A complete grid from the installed pool, or built on the calling thread without one
+static void takeFullGrid(unsigned char* cells) {
+    GridPool* pool = installedGridPool.load(memory_order_acquire);
+    if (pool) pool->take(cells);
+    else generateFullGrid(cells);
+}
+
 int** generateBoard(const int& empty_boxes){
-    /**
-     * @brief Generates a solvable Sudoku board with a specified number of empty cells.
-     *
-     * TODO:
-     * - Implement helper functions in the correct order to:
-     *   1. Initialize an empty board.
-     *   2. Fill the diagonal 3x3 boxes.
-     *   3. Solve the board to complete it.
-     *   4. Randomly delete cells to create a playable puzzle.
-     *
-     * Hints:
-     * - Use `getEmptyBoard()`, `fillBoardWithIndependentBox()`, `solve()`, and `deleteRandomItems()`.
-     * - Ensure the board remains solvable after deleting cells.
-     *
-     * @param empty_boxes The number of cells to be emptied in the generated puzzle.
-     * @return int** A dynamically allocated 9x9 Sudoku board with 'empty_boxes' empty cells.
-     */
-
-    // Dummy implementation: Returning static sudoku board
-    int** BOARD = new int*[9];
-    BOARD[0] = new int[9] {0, 0, 4, 0, 5, 0, 0, 0, 0};
-    BOARD[1] = new int[9] {9, 0, 0, 7, 3, 4, 6, 0, 0};
-    BOARD[2] = new int[9] {0, 0, 3, 0, 2, 1, 0, 4, 9};
-    BOARD[3] = new int[9] {0, 3, 5, 0, 9, 0, 4, 8, 0};
-    BOARD[4] = new int[9] {0, 9, 0, 0, 0, 0, 0, 3, 0};
-    BOARD[5] = new int[9] {0, 7, 6, 0, 1, 0, 9, 2, 0};
-    BOARD[6] = new int[9] {3, 1, 0, 9, 7, 0, 2, 0, 0};
-    BOARD[7] = new int[9] {0, 0, 9, 1, 8, 2, 0, 0, 3};
-    BOARD[8] = new int[9] {0, 0, 0, 0, 6, 0, 1, 0, 0};
+    SUDOKU_TRACE_SCOPE("generateBoard");
+
+    unsigned char cells[SUDOKU_CELLS];
+    takeFullGrid(cells);
+    int** BOARD = getEmptyBoard();
+    cellsToBoard(cells, BOARD);
+    deleteRandomItems(BOARD, empty_boxes);
+    return BOARD;
+}
+
+// Takes the filled cells `cells[0..size)` out of a state with a unique solution and returns `true` if the
+// solution stays unique, leaving them empty; otherwise puts them back and returns `false`.
+//
+// A second solution differs from the known one in some of these cells; the test enumerates it by the
+// first such cell j. Going from the last cell down, cell j is taken out of the masks and each of its other
+// candidates is tried with countCompactSolutions() while the cells before j keep their clue and the cells
+// after j are empty. The rest of the state is reused as is, so a test only searches cells already empty;
+// for a single cell it reduces to trying its other candidates.
+static bool removeCluesIfUnique(CompactSudokuState& state, const unsigned char* cells, const int& size) {
+    RemovalCounters& counters = removalCounters;
+    counters.tested++;
+    int digits[MAX_ORBIT_SIZE];
+    for (int j = 0; j < size; j++) digits[j] = compactCell(state, cells[j]);
+
+    for (int j = size - 1; j >= 0; j--) {
+        const int cell = cells[j];
+        const unsigned short bit = static_cast<unsigned short>(1 << (digits[j] - 1));
+        toggleCompactDigit(state, cell, bit);
 
+        bool unique = true;
+        for (unsigned short others = compactCandidates(state, cell) & ~bit; others && unique; others &= others - 1) {
+            const unsigned short other = others & -others;
+            toggleCompactDigit(state, cell, other);
+            setCompactCell(state, cell, lowestMaskBit(other) + 1);
+            counters.searches++;
+            unique = countCompactSolutions(state, 1) == 0;
+            toggleCompactDigit(state, cell, other);
+        }
+
+        if (unique) {
+            setCompactCell(state, cell, 0);
+            state.empty[state.empty_count++] = static_cast<unsigned char>(cell);
+            continue;
+        }
+
+        // Put the clues back, then drop the refilled cells from the empty-cell list (the search reorders it)
+        for (int k = j; k < size; k++) {
+            toggleCompactDigit(state, cells[k], static_cast<unsigned short>(1 << (digits[k] - 1)));
+            setCompactCell(state, cells[k], digits[k]);
+        }
+        int kept = 0;
+        for (int i = 0; i < state.empty_count; i++) {
+            if (compactCell(state, state.empty[i]) == 0) state.empty[kept++] = state.empty[i];
+        }
+        state.empty_count = static_cast<unsigned char>(kept);
+        counters.rejected++;
+        return false;
+    }
+    return true;
+}
+
+// Alternatives left to the clues of an orbit once they are removed, ignoring each other: the fewer there
+// are, the less a removal can break uniqueness. A clue without any alternative is always removable.
+static int orbitAlternatives(const CompactSudokuState& state, const unsigned char* cells, const int& size) {
+    int alternatives = 0;
+    for (int i = 0; i < size; i++) alternatives += countMaskBits(compactCandidates(state, cells[i]));
+    return alternatives;
+}
+
+// Removes clue orbits of `symmetry` from a uniquely solvable state as long as the solution stays unique,
+// until `target_empty` cells are empty (orbits that would overshoot it are skipped). Orbits with some cell
+// already empty are skipped too, so the pattern of a symmetric input stays symmetric; without symmetry and
+// target the result is a minimal puzzle. The orbits are shuffled, then visited in that order
+// (REMOVAL_RANDOM) or, at each step, the remaining orbit with the fewest alternatives first.
+static void minimizeCompactState(CompactSudokuState& state, const ClueSymmetry& symmetry, const RemovalOrder& order,
+                                 const int& target_empty) {
+    const ClueOrbits& orbits = CLUE_ORBITS[symmetry];
+    int pending[SUDOKU_CELLS];
+    int pending_count = 0;
+    for (int orbit = 0; orbit < orbits.count; orbit++) {
+        bool filled = true;
+        for (int i = 0; i < orbits.size[orbit]; i++) filled = filled && compactCell(state, orbits.cells[orbit][i]) != 0;
+        if (filled) pending[pending_count++] = orbit;
+    }
+    shuffle(pending, pending + pending_count, generatorEngine());
+
+    for (int i = 0; i < pending_count && state.empty_count < target_empty; i++) {
+        if (order == REMOVAL_FEWEST_ALTERNATIVES) {
+            // Removals change the candidates of the remaining clues, so the best orbit is picked again each step
+            int best = i, best_alternatives = INT_MAX;
+            for (int k = i; k < pending_count && best_alternatives > 0; k++) {
+                if (state.empty_count + orbits.size[pending[k]] > target_empty) continue;
+                const int alternatives = orbitAlternatives(state, orbits.cells[pending[k]], orbits.size[pending[k]]);
+                if (alternatives < best_alternatives) {
+                    best = k;
+                    best_alternatives = alternatives;
+                }
+            }
+            swap(pending[i], pending[best]);
+        }
+        const int orbit = pending[i];
+        if (state.empty_count + orbits.size[orbit] > target_empty) continue; // Would overshoot the target
+        removeCluesIfUnique(state, orbits.cells[orbit], orbits.size[orbit]);
+    }
+}
+
+bool minimizePuzzle(int** BOARD, const ClueSymmetry& symmetry, const RemovalOrder& order) {
+    CompactSudokuState state;
+    if (!loadCompactState(BOARD, state) || countCompactSolutions(state, 2) != 1) return false;
+    minimizeCompactState(state, symmetry, order, SUDOKU_CELLS);
+    storeCompactState(state, BOARD);
+    return true;
+}
+
+int** generateUniqueBoard(const int& empty_boxes, const ClueSymmetry& symmetry, const RemovalOrder& order) {
+    SUDOKU_TRACE_SCOPE("generateUniqueBoard");
+
+    unsigned char cells[SUDOKU_CELLS];
+    takeFullGrid(cells);
+    CompactSudokuState state;
+    loadCompactState(cells, state);
+    minimizeCompactState(state, symmetry, order, empty_boxes);
+    int** BOARD = getEmptyBoard();
+    storeCompactState(state, BOARD);
+    return BOARD;
+}
+
+int** generateMinimalBoard(const ClueSymmetry& symmetry, const RemovalOrder& order) {
+    SUDOKU_TRACE_SCOPE("generateMinimalBoard");
+
+    unsigned char cells[SUDOKU_CELLS];
+    takeFullGrid(cells);
+    CompactSudokuState state;
+    loadCompactState(cells, state);
+    minimizeCompactState(state, symmetry, order, SUDOKU_CELLS);
+    int** BOARD = getEmptyBoard();
+    storeCompactState(state, BOARD);
     return BOARD;
-}
\ No newline at end of file
+}
+
+const char* clueSymmetryName(const ClueSymmetry& symmetry) {
+    switch (symmetry) {
+    case SYMMETRY_ROTATIONAL:
+        return "rotational";
+    case SYMMETRY_DIAGONAL:
+        return "diagonal";
+    case SYMMETRY_DIHEDRAL:
+        return "dihedral";
+    default:
+        return "none";
+    }
+}
+
+bool clueSymmetryFromName(const string& name, ClueSymmetry& symmetry) {
+    for (int s = 0; s < CLUE_SYMMETRY_COUNT; s++) {
+        if (name == clueSymmetryName(static_cast<ClueSymmetry>(s))) {
+            symmetry = static_cast<ClueSymmetry>(s);
+            return true;
+        }
+    }
+    return false;
+}
+
+const char* removalOrderName(const RemovalOrder& order) {
+    return order == REMOVAL_FEWEST_ALTERNATIVES ? "fewest-alternatives" : "random";
+}
+
+bool removalOrderFromName(const string& name, RemovalOrder& order) {
+    for (int o = 0; o < REMOVAL_ORDER_COUNT; o++) {
+        if (name == removalOrderName(static_cast<RemovalOrder>(o))) {
+            order = static_cast<RemovalOrder>(o);
+            return true;
+        }
+    }
+    return false;
+}
+
+const char* gridSamplerName(const GridSampler& sampler) {
+    return sampler == GRID_SAMPLER_UNIFORM ? "uniform" : "diagonal-fill";
+}
+
+bool gridSamplerFromName(const string& name, GridSampler& sampler) {
+    for (int g = 0; g < GRID_SAMPLER_COUNT; g++) {
+        if (name == gridSamplerName(static_cast<GridSampler>(g))) {
+            sampler = static_cast<GridSampler>(g);
+            return true;
+        }
+    }
+    return false;
+}
@@ -0,0 +1,87 @@
+/**
+ * @file grid_pool.cpp
+ * @brief Implementation of the pool of ready full grids.
+ *
+ * Detailed descriptions are provided in the corresponding header file.
+ */
+
+#include "../include/grid_pool.h"
+#include "../include/generator.h"
+#include "../include/sudoku_tables.h"
+#include "../include/trace.h"
+#include <algorithm>
+#include <cstring>
+
+GridPool::GridPool(const unsigned& depth, const unsigned& workerCount)
+    : capacity(max(1u, depth)), lowWater(capacity / 2), grids(static_cast<size_t>(capacity) * SUDOKU_CELLS) {
+    for (unsigned i = 0; i < max(1u, workerCount); i++) workers.emplace_back(&GridPool::workerLoop, this);
+}
+
+GridPool::~GridPool() {
+    {
+        lock_guard<mutex> guard(lock);
+        stopping = true;
+    }
+    refillNeeded.notify_all();
+    for (thread& worker : workers) worker.join();
+}
+
+bool GridPool::take(unsigned char* cells) {
+    unique_lock<mutex> guard(lock);
+    if (count == 0) {
+        counters.misses++;
+        const bool wake = !refilling;
+        refilling = true;
+        guard.unlock();
+        if (wake) refillNeeded.notify_all();
+        generateFullGrid(cells);
+        return false;
+    }
+    memcpy(cells, &grids[static_cast<size_t>(head) * SUDOKU_CELLS], SUDOKU_CELLS);
+    head = (head + 1) % capacity;
+    count--;
+    counters.hits++;
+    // Wake the workers only when crossing the low-water mark: they then refill in one batch instead of
+    // being woken (a context switch) by every request
+    const bool wake = !refilling && count <= lowWater;
+    if (wake) refilling = true;
+    guard.unlock();
+    if (wake) refillNeeded.notify_all();
+    return true;
+}
+
+unsigned GridPool::size() const {
+    lock_guard<mutex> guard(lock);
+    return count;
+}
+
+unsigned GridPool::depth() const {
+    return capacity;
+}
+
+GridPoolStats GridPool::stats() const {
+    lock_guard<mutex> guard(lock);
+    return counters;
+}
+
+void GridPool::workerLoop() {
+    setTraceThreadName("grid-pool");
+    unsigned char cells[SUDOKU_CELLS];
+    for (;;) {
+        {
+            unique_lock<mutex> guard(lock);
+            refillNeeded.wait(guard, [this]() { return stopping || refilling; });
+            if (stopping) return;
+        }
+
+        // Built outside the lock, so take() only ever waits for a copy
+        generateFullGrid(cells);
+
+        lock_guard<mutex> guard(lock);
+        if (count == capacity) continue; // Another worker filled the last slot meanwhile
+        memcpy(&grids[static_cast<size_t>((head + count) % capacity) * SUDOKU_CELLS], cells, SUDOKU_CELLS);
+        count++;
+        counters.produced++;
+        if (count == capacity) refilling = false;
+    }
+}
@@ -0,0 +1,280 @@
+/**
+ * @file hint.cpp
+ * @brief Implementation of the incremental hint service.
+ *
+ * Keeps per-cell candidate bitmasks and per-unit digit masks so that a move
+ * only touches the 20 peers of the changed cell. Hints are searched from the
+ * cheapest technique to the most expensive one. Detailed function descriptions
+ * are provided in the corresponding header file.
+ */
+
+#include "../include/hint.h"
+#include "../include/sudoku.h"
+#include "../include/sudoku_tables.h"
+
+using namespace std;
+
+namespace {
+
+const unsigned short ALL_DIGITS = 0x3FE; // bits 1..9
+
+// Units 0-8 are rows, 9-17 are columns and 18-26 are boxes (see sudoku_tables.h).
+const auto& UNIT_CELLS = SUDOKU_TABLES.unit_cells;
+
+Hint makeHint(const int& cell, const int& k, const HintTechnique& technique) {
+    return {cell / 9, cell % 9, k, technique};
+}
+
+Hint noHint() {
+    return {-1, -1, 0, HINT_NONE};
+}
+
+// Full houses, then hidden singles, then naked singles. Also detects dead cells.
+bool findSingle(HintState& state, Hint& hint) {
+    for (int u = 0; u < 27; u++) {
+        int empty = -1, emptyCount = 0;
+        for (int i = 0; i < 9; i++) {
+            int cell = UNIT_CELLS[u][i];
+            if (state.cells[cell] == 0) {
+                empty = cell;
+                emptyCount++;
+            }
+        }
+        if (emptyCount == 1 && countMaskBits(state.candidates[empty]) == 1) {
+            hint = makeHint(empty, lowestMaskBit(state.candidates[empty]), HINT_FULL_HOUSE);
+            return true;
+        }
+    }
+
+    for (int u = 0; u < 27; u++) {
+        unsigned short once = 0, twice = 0, placed = 0;
+        for (int i = 0; i < 9; i++) {
+            int cell = UNIT_CELLS[u][i];
+            if (state.cells[cell] != 0) {
+                placed |= 1 << state.cells[cell];
+                continue;
+            }
+            twice |= once & state.candidates[cell];
+            once |= state.candidates[cell];
+        }
+        if ((once | placed) != ALL_DIGITS) {
+            state.contradiction = true; // Some digit has no place left in this unit
+            return false;
+        }
+        unsigned short exactly = once & ~twice;
+        if (exactly == 0) continue;
+        int k = lowestMaskBit(exactly);
+        for (int i = 0; i < 9; i++) {
+            int cell = UNIT_CELLS[u][i];
+            if (state.cells[cell] == 0 && (state.candidates[cell] & (1 << k))) {
+                hint = makeHint(cell, k, HINT_HIDDEN_SINGLE);
+                return true;
+            }
+        }
+    }
+
+    for (int cell = 0; cell < 81; cell++) {
+        if (state.cells[cell] != 0) continue;
+        if (state.candidates[cell] == 0) {
+            state.contradiction = true;
+            return false;
+        }
+        if (countMaskBits(state.candidates[cell]) == 1) {
+            hint = makeHint(cell, lowestMaskBit(state.candidates[cell]), HINT_NAKED_SINGLE);
+            return true;
+        }
+    }
+    return false;
+}
+
+// Removes digit k from every empty cell of unit u that is not in the skip unit.
+bool eliminateOutside(HintState& state, const int& u, const int& skip, const int& k) {
+    bool changed = false;
+    for (int i = 0; i < 9; i++) {
+        int cell = UNIT_CELLS[u][i];
+        if (state.cells[cell] != 0 || !(state.candidates[cell] & (1 << k))) continue;
+        if (SUDOKU_TABLES.cell_units[cell][skip / 9] != skip) {
+            state.candidates[cell] &= ~(1 << k);
+            changed = true;
+        }
+    }
+    return changed;
+}
+
+// Pointing (box -> line) and claiming (line -> box) eliminations.
+bool applyLockedCandidates(HintState& state) {
+    bool changed = false;
+    for (int u = 0; u < 27; u++) {
+        for (int k = 1; k <= 9; k++) {
+            int rowMask = 0, colMask = 0, boxMask = 0, count = 0;
+            for (int i = 0; i < 9; i++) {
+                int cell = UNIT_CELLS[u][i];
+                if (state.cells[cell] == 0 && (state.candidates[cell] & (1 << k))) {
+                    rowMask |= 1 << SUDOKU_TABLES.row_of[cell];
+                    colMask |= 1 << SUDOKU_TABLES.col_of[cell];
+                    boxMask |= 1 << SUDOKU_TABLES.box_of[cell];
+                    count++;
+                }
+            }
+            if (count < 2) continue;
+            if (u >= 18) {
+                // All candidates of the box lie in one row or one column
+                if (countMaskBits(rowMask) == 1) changed |= eliminateOutside(state, lowestMaskBit(rowMask), u, k);
+                if (countMaskBits(colMask) == 1) changed |= eliminateOutside(state, 9 + lowestMaskBit(colMask), u, k);
+            } else if (countMaskBits(boxMask) == 1) {
+                // All candidates of the line lie in one box
+                changed |= eliminateOutside(state, 18 + lowestMaskBit(boxMask), u, k);
+            }
+            if (changed) return true;
+        }
+    }
+    return false;
+}
+
+bool applyNakedPairs(HintState& state) {
+    for (int u = 0; u < 27; u++) {
+        for (int i = 0; i < 9; i++) {
+            int a = UNIT_CELLS[u][i];
+            if (state.cells[a] != 0 || countMaskBits(state.candidates[a]) != 2) continue;
+            for (int j = i + 1; j < 9; j++) {
+                int b = UNIT_CELLS[u][j];
+                if (state.cells[b] != 0 || state.candidates[b] != state.candidates[a]) continue;
+                bool changed = false;
+                for (int l = 0; l < 9; l++) {
+                    int cell = UNIT_CELLS[u][l];
+                    if (cell == a || cell == b || state.cells[cell] != 0) continue;
+                    if (state.candidates[cell] & state.candidates[a]) {
+                        state.candidates[cell] &= ~state.candidates[a];
+                        changed = true;
+                    }
+                }
+                if (changed) return true;
+            }
+        }
+    }
+    return false;
+}
+
+Hint backtrackingHint(HintState& state) {
+    int rows[9][9];
+    int* board[9];
+    for (int r = 0; r < 9; r++) {
+        board[r] = rows[r];
+        for (int c = 0; c < 9; c++) rows[r][c] = state.cells[r * 9 + c];
+    }
+    if (!solve(board, true)) {
+        state.contradiction = true;
+        return noHint();
+    }
+
+    // Reveal the most constrained cell, it is the one the player is closest to
+    int best = -1;
+    for (int cell = 0; cell < 81; cell++) {
+        if (state.cells[cell] != 0) continue;
+        if (best == -1 || countMaskBits(state.candidates[cell]) < countMaskBits(state.candidates[best])) best = cell;
+    }
+    if (best == -1) return noHint();
+    return makeHint(best, rows[best / 9][best % 9], HINT_BACKTRACKING);
+}
+
+} // namespace
+
+void initHintState(int** BOARD, HintState& state) {
+    for (int i = 0; i < 9; i++) {
+        state.rowUsed[i] = state.colUsed[i] = state.boxUsed[i] = 0;
+    }
+    state.emptyCount = 81;
+    state.contradiction = false;
+    for (int cell = 0; cell < 81; cell++) {
+        state.cells[cell] = 0;
+        state.candidates[cell] = ALL_DIGITS;
+    }
+    for (int r = 0; r < 9; r++) {
+        for (int c = 0; c < 9; c++) {
+            if (BOARD[r][c] != 0 && !applyHintMove(state, r, c, BOARD[r][c])) state.contradiction = true;
+        }
+    }
+}
+
+bool applyHintMove(HintState& state, const int& r, const int& c, const int& k) {
+    int cell = r * 9 + c;
+    int b = SUDOKU_TABLES.box_of[cell];
+    unsigned short bit = 1 << k;
+    if (state.cells[cell] != 0 || ((state.rowUsed[r] | state.colUsed[c] | state.boxUsed[b]) & bit)) {
+        state.contradiction = true;
+        return false;
+    }
+
+    state.cells[cell] = k;
+    state.candidates[cell] = 0;
+    state.rowUsed[r] |= bit;
+    state.colUsed[c] |= bit;
+    state.boxUsed[b] |= bit;
+    state.emptyCount--;
+
+    // Remove k from the 20 peers in the row, column and box
+    for (int i = 0; i < SUDOKU_PEERS; i++) {
+        state.candidates[SUDOKU_TABLES.peers[cell][i]] &= ~bit;
+    }
+    return true;
+}
+
+void syncHintState(HintState& state, int** BOARD) {
+    for (int r = 0; r < 9; r++) {
+        for (int c = 0; c < 9; c++) {
+            int current = state.cells[r * 9 + c];
+            if (current != 0 && BOARD[r][c] != current) {
+                initHintState(BOARD, state); // A cell was cleared or changed
+                return;
+            }
+        }
+    }
+    for (int r = 0; r < 9; r++) {
+        for (int c = 0; c < 9; c++) {
+            if (state.cells[r * 9 + c] == 0 && BOARD[r][c] != 0) applyHintMove(state, r, c, BOARD[r][c]);
+        }
+    }
+}
+
+Hint nextHint(HintState& state) {
+    if (state.contradiction || state.emptyCount == 0) return noHint();
+
+    Hint hint = noHint();
+    if (findSingle(state, hint)) return hint;
+    if (state.contradiction) return noHint();
+
+    HintTechnique level = HINT_NONE;
+    for (;;) {
+        if (applyLockedCandidates(state)) {
+            if (level < HINT_LOCKED_CANDIDATES) level = HINT_LOCKED_CANDIDATES;
+        } else if (applyNakedPairs(state)) {
+            level = HINT_NAKED_PAIR;
+        } else {
+            break;
+        }
+        if (findSingle(state, hint)) {
+            hint.technique = level;
+            return hint;
+        }
+        if (state.contradiction) return noHint();
+    }
+    return backtrackingHint(state);
+}
+
+Hint nextHint(int** BOARD) {
+    HintState state;
+    initHintState(BOARD, state);
+    return nextHint(state);
+}
+
+const char* hintTechniqueName(const HintTechnique& technique) {
+    switch (technique) {
+        case HINT_FULL_HOUSE: return "Full House";
+        case HINT_HIDDEN_SINGLE: return "Hidden Single";
+        case HINT_NAKED_SINGLE: return "Naked Single";
+        case HINT_LOCKED_CANDIDATES: return "Locked Candidates";
+        case HINT_NAKED_PAIR: return "Naked Pair";
+        case HINT_BACKTRACKING: return "Backtracking";
+        default: return "None";
+    }
+}
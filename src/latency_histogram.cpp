@@ -0,0 +1,277 @@
+/**
+ * @file latency_histogram.cpp
+ * @brief Implementation of the log-linear latency histogram.
+ *
+ * Bucket `i < 2^S` holds the exact value `i`. Above that, a value with its
+ * highest set bit at position `m` falls into power-of-two group `e = m - S + 1`
+ * and sub-bucket `v >> e`, which lies in [2^(S-1), 2^S). Detailed function
+ * descriptions are provided in the corresponding header file.
+ */
+
+#include "../include/latency_histogram.h"
+#include <cmath>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+#include <utility>
+
+using namespace std;
+
+static const int SUB_BUCKETS = 1 << LATENCY_SUB_BUCKET_BITS;
+static const int HALF_SUB_BUCKETS = SUB_BUCKETS / 2;
+static const unsigned long long NO_MINIMUM = numeric_limits<unsigned long long>::max();
+
+static int highestBit(unsigned long long value) {
+    int bit = 0;
+    while (value >>= 1) bit++;
+    return bit;
+}
+
+int LatencyHistogram::bucketIndex(const unsigned long long& value) {
+    if (value < static_cast<unsigned long long>(SUB_BUCKETS)) return static_cast<int>(value);
+    const int shift = highestBit(value) - LATENCY_SUB_BUCKET_BITS + 1;
+    return shift * HALF_SUB_BUCKETS + static_cast<int>(value >> shift);
+}
+
+unsigned long long LatencyHistogram::bucketLowest(const int& index) {
+    if (index < SUB_BUCKETS) return index;
+    const int shift = index / HALF_SUB_BUCKETS - 1;
+    const unsigned long long sub = index - shift * HALF_SUB_BUCKETS;
+    return sub << shift;
+}
+
+unsigned long long LatencyHistogram::bucketHighest(const int& index) {
+    if (index < SUB_BUCKETS) return index;
+    const int shift = index / HALF_SUB_BUCKETS - 1;
+    return bucketLowest(index) + ((1ULL << shift) - 1);
+}
+
+LatencyHistogram::LatencyHistogram()
+    : counts(new atomic<unsigned long long>[LATENCY_BUCKET_COUNT]), total(0), minimum(NO_MINIMUM), maximum(0), sum(0) {
+    for (int i = 0; i < LATENCY_BUCKET_COUNT; i++) counts[i].store(0, memory_order_relaxed);
+}
+
+LatencyHistogram::LatencyHistogram(const LatencyHistogram& other) : LatencyHistogram() {
+    merge(other);
+}
+
+LatencyHistogram& LatencyHistogram::operator=(const LatencyHistogram& other) {
+    if (this != &other) {
+        reset();
+        merge(other);
+    }
+    return *this;
+}
+
+void LatencyHistogram::record(const unsigned long long& nanoseconds) {
+    counts[bucketIndex(nanoseconds)].fetch_add(1, memory_order_relaxed);
+    total.fetch_add(1, memory_order_relaxed);
+    sum.fetch_add(nanoseconds, memory_order_relaxed);
+
+    unsigned long long seen = minimum.load(memory_order_relaxed);
+    while (nanoseconds < seen && !minimum.compare_exchange_weak(seen, nanoseconds, memory_order_relaxed)) {}
+    seen = maximum.load(memory_order_relaxed);
+    while (nanoseconds > seen && !maximum.compare_exchange_weak(seen, nanoseconds, memory_order_relaxed)) {}
+}
+
+void LatencyHistogram::recordSeconds(const double& seconds) {
+    record(seconds <= 0 ? 0 : static_cast<unsigned long long>(seconds * 1e9 + 0.5));
+}
+
+void LatencyHistogram::addBucket(const int& index, const unsigned long long& count) {
+    if (count == 0) return;
+    counts[index].fetch_add(count, memory_order_relaxed);
+    total.fetch_add(count, memory_order_relaxed);
+
+    // Bucket midpoints keep the sum approximately right for deserialized histograms
+    const unsigned long long low = bucketLowest(index), high = bucketHighest(index);
+    sum.fetch_add(count * (low + (high - low) / 2), memory_order_relaxed);
+
+    unsigned long long seen = minimum.load(memory_order_relaxed);
+    while (low < seen && !minimum.compare_exchange_weak(seen, low, memory_order_relaxed)) {}
+    seen = maximum.load(memory_order_relaxed);
+    while (high > seen && !maximum.compare_exchange_weak(seen, high, memory_order_relaxed)) {}
+}
+
+void LatencyHistogram::merge(const LatencyHistogram& other) {
+    for (int i = 0; i < LATENCY_BUCKET_COUNT; i++) {
+        const unsigned long long count = other.counts[i].load(memory_order_relaxed);
+        if (count != 0) counts[i].fetch_add(count, memory_order_relaxed);
+    }
+    total.fetch_add(other.total.load(memory_order_relaxed), memory_order_relaxed);
+    sum.fetch_add(other.sum.load(memory_order_relaxed), memory_order_relaxed);
+
+    const unsigned long long otherMin = other.minimum.load(memory_order_relaxed);
+    unsigned long long seen = minimum.load(memory_order_relaxed);
+    while (otherMin < seen && !minimum.compare_exchange_weak(seen, otherMin, memory_order_relaxed)) {}
+    const unsigned long long otherMax = other.maximum.load(memory_order_relaxed);
+    seen = maximum.load(memory_order_relaxed);
+    while (otherMax > seen && !maximum.compare_exchange_weak(seen, otherMax, memory_order_relaxed)) {}
+}
+
+void LatencyHistogram::reset() {
+    for (int i = 0; i < LATENCY_BUCKET_COUNT; i++) counts[i].store(0, memory_order_relaxed);
+    total.store(0, memory_order_relaxed);
+    sum.store(0, memory_order_relaxed);
+    minimum.store(NO_MINIMUM, memory_order_relaxed);
+    maximum.store(0, memory_order_relaxed);
+}
+
+unsigned long long LatencyHistogram::count() const {
+    return total.load(memory_order_relaxed);
+}
+
+unsigned long long LatencyHistogram::min() const {
+    const unsigned long long value = minimum.load(memory_order_relaxed);
+    return value == NO_MINIMUM ? 0 : value;
+}
+
+unsigned long long LatencyHistogram::max() const {
+    return maximum.load(memory_order_relaxed);
+}
+
+double LatencyHistogram::mean() const {
+    const unsigned long long n = count();
+    return n == 0 ? 0.0 : static_cast<double>(sum.load(memory_order_relaxed)) / n;
+}
+
+double LatencyHistogram::standardDeviation() const {
+    const unsigned long long n = count();
+    if (n == 0) return 0.0;
+    const double average = mean();
+    double squares = 0.0;
+    for (int i = 0; i < LATENCY_BUCKET_COUNT; i++) {
+        const unsigned long long bucketCount = counts[i].load(memory_order_relaxed);
+        if (bucketCount == 0) continue;
+        const double middle = (static_cast<double>(bucketLowest(i)) + static_cast<double>(bucketHighest(i))) / 2.0;
+        squares += bucketCount * (middle - average) * (middle - average);
+    }
+    return sqrt(squares / n);
+}
+
+unsigned long long LatencyHistogram::valueAtPercentile(const double& percentile) const {
+    const unsigned long long n = count();
+    if (n == 0) return 0;
+    const double clamped = percentile < 0 ? 0 : (percentile > 100 ? 100 : percentile);
+    unsigned long long target = static_cast<unsigned long long>(ceil(clamped / 100.0 * n));
+    if (target == 0) target = 1;
+
+    unsigned long long seen = 0;
+    for (int i = 0; i < LATENCY_BUCKET_COUNT; i++) {
+        seen += counts[i].load(memory_order_relaxed);
+        if (seen >= target) {
+            const unsigned long long high = bucketHighest(i);
+            return high < max() ? high : max();
+        }
+    }
+    return max();
+}
+
+void LatencyHistogram::outputPercentileDistribution(ostream& out, const double& unitScale, const int& ticksPerHalfDistance) const {
+    const ios::fmtflags flags = out.flags();
+    const streamsize precision = out.precision();
+    out << fixed << "       Value     Percentile TotalCount 1/(1-Percentile)\n\n";
+
+    const unsigned long long n = count();
+    const auto line = [&](const double& percentile, const unsigned long long& value) {
+        // Cumulative count of values up to and including the bucket of `value`
+        unsigned long long below = 0;
+        const int last = bucketIndex(value);
+        for (int i = 0; i <= last; i++) below += counts[i].load(memory_order_relaxed);
+        out << setw(12) << setprecision(3) << value / unitScale << " " << setw(14) << setprecision(12) << percentile / 100.0
+            << " " << setw(10) << below;
+        if (percentile < 100.0) out << " " << setw(14) << setprecision(2) << 1.0 / (1.0 - percentile / 100.0);
+        out << "\n";
+    };
+
+    if (n > 0) {
+        double percentile = 0.0;
+        // Each halving of the distance to 100% is reported with the same number of ticks
+        while (percentile < 100.0) {
+            const unsigned long long value = valueAtPercentile(percentile);
+            line(percentile, value);
+            if (value >= max()) break;
+            const double halfDistance = pow(2.0, floor(log2(100.0 / (100.0 - percentile))) + 1);
+            percentile += 100.0 / (ticksPerHalfDistance * halfDistance);
+        }
+        line(100.0, max());
+    }
+
+    out << setprecision(3);
+    out << "#[Mean    = " << setw(12) << mean() / unitScale << ", StdDeviation   = " << setw(12)
+        << standardDeviation() / unitScale << "]\n";
+    out << "#[Max     = " << setw(12) << max() / unitScale << ", Total count    = " << setw(12) << n << "]\n";
+    out << "#[Buckets = " << setw(12) << LATENCY_BUCKET_COUNT / HALF_SUB_BUCKETS << ", SubBuckets     = " << setw(12)
+        << SUB_BUCKETS << "]\n";
+    out.flags(flags);
+    out.precision(precision);
+}
+
+string LatencyHistogram::summary() const {
+    ostringstream out;
+    out << fixed << setprecision(1) << "n=" << count() << " mean=" << mean() / 1000.0
+        << "us p50=" << valueAtPercentile(50) / 1000.0 << "us p90=" << valueAtPercentile(90) / 1000.0
+        << "us p99=" << valueAtPercentile(99) / 1000.0 << "us p99.9=" << valueAtPercentile(99.9) / 1000.0
+        << "us p99.99=" << valueAtPercentile(99.99) / 1000.0 << "us max=" << max() / 1000.0 << "us";
+    return out.str();
+}
+
+string LatencyHistogram::serialize() const {
+    ostringstream out;
+    bool first = true;
+    for (int i = 0; i < LATENCY_BUCKET_COUNT; i++) {
+        const unsigned long long bucketCount = counts[i].load(memory_order_relaxed);
+        if (bucketCount == 0) continue;
+        if (!first) out << " ";
+        out << i << ":" << bucketCount;
+        first = false;
+    }
+    return out.str();
+}
+
+bool LatencyHistogram::deserialize(const string& text) {
+    istringstream in(text);
+    string pair;
+    while (in >> pair) {
+        const size_t colon = pair.find(':');
+        if (colon == string::npos) return false;
+        try {
+            const int index = stoi(pair.substr(0, colon));
+            const unsigned long long bucketCount = stoull(pair.substr(colon + 1));
+            if (index < 0 || index >= LATENCY_BUCKET_COUNT) return false;
+            addBucket(index, bucketCount);
+        } catch (const exception&) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static atomic<unsigned long long> nextGroupId(1);
+
+LatencyHistogramGroup::LatencyHistogramGroup() : id(nextGroupId.fetch_add(1)) {}
+
+LatencyHistogram& LatencyHistogramGroup::local() {
+    // Group ids are never reused, so a cached entry of a destroyed group is never matched again
+    thread_local pair<unsigned long long, LatencyHistogram*> cache(0, nullptr);
+    if (cache.first == id) return *cache.second;
+    lock_guard<mutex> guard(lock);
+    const thread::id self = this_thread::get_id();
+    LatencyHistogram* histogram = nullptr;
+    for (const auto& entry : histograms) {
+        if (entry.first == self) histogram = entry.second.get();
+    }
+    if (!histogram) {
+        histograms.emplace_back(self, unique_ptr<LatencyHistogram>(new LatencyHistogram()));
+        histogram = histograms.back().second.get();
+    }
+    cache = make_pair(id, histogram);
+    return *histogram;
+}
+
+LatencyHistogram LatencyHistogramGroup::merged() const {
+    LatencyHistogram result;
+    lock_guard<mutex> guard(lock);
+    for (const auto& entry : histograms) result.merge(*entry.second);
+    return result;
+}
@@ -0,0 +1,171 @@
+/**
+ * @file puzzle_parser.cpp
+ * @brief Implementation of the one-line puzzle parser.
+ *
+ * A puzzle line is parsed in 16 or 32 byte blocks: each block is classified
+ * with vector compares (digit, '.', '-'), digits are converted by subtracting
+ * '0' and masked so that blanks become 0, and all blocks are checked at once
+ * at the end so the hot path has no branches. Detailed function descriptions
+ * are provided in the corresponding header file.
+ */
+
+#include "../include/puzzle_parser.h"
+#include <cstring>
+#include <fstream>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define SUDOKU_PARSER_SSE2
+#endif
+
+using namespace std;
+
+static inline bool parseCell(const char ch, unsigned char* out) {
+    if (ch >= '0' && ch <= '9') {
+        *out = static_cast<unsigned char>(ch - '0');
+        return true;
+    }
+    *out = 0;
+    return ch == '.' || ch == '-';
+}
+
+bool parsePuzzleLineScalar(const char* line, unsigned char* cells) {
+    bool valid = true;
+    for (int i = 0; i < PUZZLE_LINE_LENGTH; i++) {
+        valid &= parseCell(line[i], cells + i);
+    }
+    return valid;
+}
+
+#if defined(__AVX2__) || defined(SUDOKU_PARSER_SSE2)
+// Parses 16 characters, returns the validity bitmask (0xFFFF when all are legal).
+static inline int parseBlock16(const char* in, unsigned char* out) {
+    const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in));
+    const __m128i digit = _mm_and_si128(_mm_cmpgt_epi8(v, _mm_set1_epi8('0' - 1)),
+                                        _mm_cmplt_epi8(v, _mm_set1_epi8('9' + 1)));
+    const __m128i blank = _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('.')),
+                                       _mm_cmpeq_epi8(v, _mm_set1_epi8('-')));
+    const __m128i values = _mm_and_si128(_mm_sub_epi8(v, _mm_set1_epi8('0')), digit);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out), values);
+    return _mm_movemask_epi8(_mm_or_si128(digit, blank));
+}
+#endif
+
+#if defined(__AVX2__)
+// Parses 32 characters, returns true when all are legal.
+static inline bool parseBlock32(const char* in, unsigned char* out) {
+    const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in));
+    const __m256i digit = _mm256_and_si256(_mm256_cmpgt_epi8(v, _mm256_set1_epi8('0' - 1)),
+                                           _mm256_cmpgt_epi8(_mm256_set1_epi8('9' + 1), v));
+    const __m256i blank = _mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8('.')),
+                                          _mm256_cmpeq_epi8(v, _mm256_set1_epi8('-')));
+    const __m256i values = _mm256_and_si256(_mm256_sub_epi8(v, _mm256_set1_epi8('0')), digit);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out), values);
+    return _mm256_movemask_epi8(_mm256_or_si256(digit, blank)) == -1;
+}
+#endif
+
+bool parsePuzzleLine(const char* line, unsigned char* cells) {
+#if defined(__AVX2__)
+    // 81 = 32 + 32 + 16 + 1
+    bool valid = parseBlock32(line, cells);
+    valid &= parseBlock32(line + 32, cells + 32);
+    valid &= parseBlock16(line + 64, cells + 64) == 0xFFFF;
+    valid &= parseCell(line[80], cells + 80);
+    return valid;
+#elif defined(SUDOKU_PARSER_SSE2)
+    // 81 = 5 * 16 + 1
+    int mask = parseBlock16(line, cells);
+    mask &= parseBlock16(line + 16, cells + 16);
+    mask &= parseBlock16(line + 32, cells + 32);
+    mask &= parseBlock16(line + 48, cells + 48);
+    mask &= parseBlock16(line + 64, cells + 64);
+    return (mask == 0xFFFF) & parseCell(line[80], cells + 80);
+#else
+    return parsePuzzleLineScalar(line, cells);
+#endif
+}
+
+size_t parsePuzzleLines(const char* data, const size_t& size, vector<unsigned char>& cells, size_t* invalid) {
+    size_t parsed = 0;
+    size_t rejected = 0;
+    size_t offset = cells.size();
+    cells.resize(offset + (size / (PUZZLE_LINE_LENGTH + 1) + 1) * PUZZLE_LINE_LENGTH);
+
+    size_t pos = 0;
+    while (pos < size) {
+        if (offset + PUZZLE_LINE_LENGTH > cells.size()) {
+            cells.resize(cells.size() * 2); // Only happens with very short lines
+        }
+
+        // Common case: a well-formed 81 character line
+        size_t next = pos + PUZZLE_LINE_LENGTH;
+        if (next <= size && (next == size || data[next] == '\n' || data[next] == '\r')
+            && parsePuzzleLine(data + pos, cells.data() + offset)) {
+            offset += PUZZLE_LINE_LENGTH;
+            parsed++;
+        } else {
+            // Blank line, comment or malformed line: find its real end
+            const void* newline = memchr(data + pos, '\n', size - pos);
+            next = newline ? static_cast<const char*>(newline) - data : size;
+            size_t length = next - pos;
+            if (length > 0 && data[pos + length - 1] == '\r') length--;
+            if (length > 0 && data[pos] != '#') rejected++;
+        }
+
+        if (next < size && data[next] == '\r') next++;
+        if (next < size && data[next] == '\n') next++;
+        pos = next;
+    }
+
+    cells.resize(offset);
+    if (invalid) *invalid += rejected;
+    return parsed;
+}
+
+bool readPuzzleLineFile(const string& filename, vector<unsigned char>& cells, size_t* invalid) {
+    ifstream file(filename, ios::binary | ios::ate);
+    if (!file.is_open()) return false;
+    const streamsize size = file.tellg();
+    file.seekg(0);
+    vector<char> content(static_cast<size_t>(size));
+    if (size > 0 && !file.read(content.data(), size)) return false;
+    parsePuzzleLines(content.data(), content.size(), cells, invalid);
+    return true;
+}
+
+void formatPuzzleLine(int** BOARD, char* line) {
+    for (int r = 0; r < 9; r++) {
+        for (int c = 0; c < 9; c++) {
+            line[r * 9 + c] = BOARD[r][c] == 0 ? '.' : static_cast<char>('0' + BOARD[r][c]);
+        }
+    }
+}
+
+void cellsToBoard(const unsigned char* cells, int** BOARD) {
+    for (int r = 0; r < 9; r++) {
+        for (int c = 0; c < 9; c++) {
+            BOARD[r][c] = cells[r * 9 + c];
+        }
+    }
+}
+
+void boardToCells(int** BOARD, unsigned char* cells) {
+    for (int r = 0; r < 9; r++) {
+        for (int c = 0; c < 9; c++) {
+            cells[r * 9 + c] = static_cast<unsigned char>(BOARD[r][c]);
+        }
+    }
+}
+
+const char* puzzleParserBackend() {
+#if defined(__AVX2__)
+    return "avx2";
+#elif defined(SUDOKU_PARSER_SSE2)
+    return "sse2";
+#else
+    return "scalar";
+#endif
+}
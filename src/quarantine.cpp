@@ -0,0 +1,64 @@
+/**
+ * @file quarantine.cpp
+ * @brief Implementation of the quarantine corpus file.
+ *
+ * Records are formatted into one string and written with a single fwrite on a
+ * file opened in append mode, so concurrent writers never interleave inside a
+ * line. Detailed function descriptions are provided in the corresponding
+ * header file.
+ */
+
+#include "../include/quarantine.h"
+#include "../include/puzzle_parser.h"
+#include <cstdio>
+#include <fstream>
+#include <mutex>
+#include <sstream>
+
+using namespace std;
+
+static const char* const QUARANTINE_HEADER = "# sudoku quarantine v1";
+static mutex quarantineLock; // Keeps the header check and the append together within one process
+
+bool exceedsQuarantineThresholds(const double& seconds, const long long& nodes, const double& max_seconds,
+                                 const long long& max_nodes) {
+    return (max_seconds > 0 && seconds > max_seconds) || (max_nodes > 0 && nodes > max_nodes);
+}
+
+bool appendQuarantineRecord(const string& filename, const QuarantineRecord& record) {
+    ostringstream line;
+    line.precision(9);
+    line << record.puzzle << " " << record.strategy << " " << record.seconds << " " << record.nodes << " "
+         << (record.solved ? 1 : 0) << " " << (record.source.empty() ? "-" : record.source) << "\n";
+    const string text = line.str();
+
+    lock_guard<mutex> guard(quarantineLock);
+    FILE* file = fopen(filename.c_str(), "a");
+    if (!file) return false;
+    fseek(file, 0, SEEK_END);
+    bool ok = true;
+    if (ftell(file) == 0) ok = fprintf(file, "%s\n", QUARANTINE_HEADER) > 0;
+    ok = ok && fwrite(text.data(), 1, text.size(), file) == text.size();
+    return fclose(file) == 0 && ok;
+}
+
+bool loadQuarantine(const string& filename, vector<QuarantineRecord>& records) {
+    ifstream in(filename);
+    string line;
+    if (!getline(in, line) || line != QUARANTINE_HEADER) return false;
+
+    unsigned char cells[PUZZLE_LINE_LENGTH];
+    while (getline(in, line)) {
+        if (line.empty() || line[0] == '#') continue;
+        istringstream fields(line);
+        QuarantineRecord record;
+        int solved = 0;
+        fields >> record.puzzle >> record.strategy >> record.seconds >> record.nodes >> solved;
+        // The source is the last field and may contain spaces: take the rest of the line after one separator
+        if (fields.get() != ' ' || !getline(fields, record.source)) fields.setstate(ios::failbit);
+        if (fields.fail() || record.puzzle.size() != PUZZLE_LINE_LENGTH || !parsePuzzleLine(record.puzzle.c_str(), cells)) continue;
+        record.solved = solved != 0;
+        records.push_back(record);
+    }
+    return true;
+}
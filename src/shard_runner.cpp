@@ -0,0 +1,89 @@
+/**
+ * @file shard_runner.cpp
+ * @brief Implementation of the local multi-process shard runner.
+ *
+ * Processes are started with posix_spawn on POSIX systems. Elsewhere each
+ * shard is started through std::system from its own thread. Detailed function
+ * descriptions are provided in the corresponding header file.
+ */
+
+#include "../include/shard_runner.h"
+#include <cstdio>
+#include <iostream>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <spawn.h>
+#include <sys/wait.h>
+extern char** environ;
+#else
+#include <cstdlib>
+#include <thread>
+#endif
+
+using namespace std;
+
+string getShardStatsFileName(const string& stats_prefix, const int& shard_index) {
+    return stats_prefix + to_string(shard_index) + ".stats";
+}
+
+static vector<string> shardArguments(const string& executable, const vector<string>& arguments, const int& shard,
+                                     const int& shard_count, const string& stats_prefix) {
+    vector<string> argv = {executable};
+    argv.insert(argv.end(), arguments.begin(), arguments.end());
+    argv.push_back("--shard");
+    argv.push_back(to_string(shard) + "/" + to_string(shard_count));
+    argv.push_back("--stats-out");
+    argv.push_back(getShardStatsFileName(stats_prefix, shard));
+    return argv;
+}
+
+int runShardedJob(const string& executable, const int& shard_count, const vector<string>& arguments,
+                  const string& stats_prefix, BatchStats& merged) {
+    vector<char> succeeded(shard_count, 0);
+    for (int shard = 0; shard < shard_count; shard++) remove(getShardStatsFileName(stats_prefix, shard).c_str());
+
+#if defined(__unix__) || defined(__APPLE__)
+    vector<pid_t> children(shard_count, -1);
+    for (int shard = 0; shard < shard_count; shard++) {
+        vector<string> args = shardArguments(executable, arguments, shard, shard_count, stats_prefix);
+        vector<char*> argv;
+        for (string& arg : args) argv.push_back(&arg[0]);
+        argv.push_back(nullptr);
+        if (posix_spawnp(&children[shard], executable.c_str(), nullptr, nullptr, argv.data(), environ) != 0) {
+            cerr << "Failed to start shard " << shard << endl;
+            children[shard] = -1;
+        }
+    }
+    for (int shard = 0; shard < shard_count; shard++) {
+        int status = 0;
+        if (children[shard] > 0 && waitpid(children[shard], &status, 0) == children[shard]) {
+            succeeded[shard] = WIFEXITED(status) && WEXITSTATUS(status) == 0;
+        }
+    }
+#else
+    vector<thread> runners;
+    for (int shard = 0; shard < shard_count; shard++) {
+        runners.emplace_back([&, shard]() {
+            string command;
+            for (const string& arg : shardArguments(executable, arguments, shard, shard_count, stats_prefix)) {
+                command += "\"" + arg + "\" ";
+            }
+            succeeded[shard] = system(command.c_str()) == 0;
+        });
+    }
+    for (thread& runner : runners) runner.join();
+#endif
+
+    int failures = 0;
+    merged = BatchStats();
+    for (int shard = 0; shard < shard_count; shard++) {
+        BatchStats stats;
+        if (succeeded[shard] && loadBatchStats(stats, getShardStatsFileName(stats_prefix, shard))) {
+            mergeBatchStats(merged, stats);
+        } else {
+            cerr << "!! Shard " << shard << "/" << shard_count << " failed" << endl;
+            failures++;
+        }
+    }
+    return failures;
+}
@@ -14,10 +14,22 @@
  */
 
 #include "../include/sudoku.h"
+#include "../include/compact_state.h"
+#include "../include/solver_trail.h"
+#include "../include/sudoku_tables.h"
+#include "../include/trace.h"
 #include <iostream>
 #include <tuple>
+#include <climits>
 using namespace std;
 
+// Search nodes visited by the solvers on this thread (see getSolveNodeCount())
+static thread_local long long solveNodeCount = 0;
+// Node limit per solve() (0: none) and the node count at which the running solve() gives up
+static thread_local long long solveNodeLimit = 0;
+static thread_local long long solveNodeBudgetEnd = LLONG_MAX;
+static thread_local bool solveGaveUp = false;
+
 bool isValid(int **BOARD, const int &r, const int &c, const int &k)
 {
     // Check if 'k' already exists in the same row or column
@@ -27,18 +39,12 @@ bool isValid(int **BOARD, const int &r, const int &c, const int &k)
             return false; // Invalid placement
     }
 
-    // Determine starting indices for the 3x3 subgrid
-    int startRow = 3 * (r / 3);
-    int startCol = 3 * (c / 3);
-
-    // Check if 'k' exists in the 3x3 subgrid
-    for (int i = startRow; i < startRow + 3; i++)
+    // Check the 4 cells of the 3x3 subgrid outside that row and column (precomputed peers)
+    const unsigned char *boxPeers = SUDOKU_TABLES.peers[r * 9 + c] + SUDOKU_BOX_ONLY_PEERS;
+    for (int i = 0; i < 4; i++)
     {
-        for (int j = startCol; j < startCol + 3; j++)
-        {
-            if (k == BOARD[i][j])
-                return false; // Invalid placement
-        }
+        if (k == BOARD[SUDOKU_TABLES.row_of[boxPeers[i]]][SUDOKU_TABLES.col_of[boxPeers[i]]])
+            return false; // Invalid placement
     }
 
     return true; // Placement is valid
@@ -63,6 +69,11 @@ bool solveBoard(int **BOARD, const int &r, const int &c)
     {
         if (isValid(BOARD, r, c, k))
         {
+            if (++solveNodeCount > solveNodeBudgetEnd)
+            {
+                solveGaveUp = true;
+                return false; // Node limit reached: unwind without trying other digits
+            }
             BOARD[r][c] = k; // Place number 'k'
 
             // Recursively attempt to solve the rest of the board
@@ -126,6 +137,11 @@ bool solveBoardEfficient(int **BOARD)
     {
         if (isValid(BOARD, row, col, k)) // Check if placing 'k' is a valid solution
         {
+            if (++solveNodeCount > solveNodeBudgetEnd)
+            {
+                solveGaveUp = true;
+                return false; // Node limit reached: unwind without trying other digits
+            }
             BOARD[row][col] = k; // Place the number
 
             if (solveBoardEfficient(BOARD))
@@ -137,8 +153,293 @@ bool solveBoardEfficient(int **BOARD)
     return false; // Trigger backtracking if no valid number can be placed
 }
 
+namespace
+{
+
+const unsigned short ALL_CANDIDATES = 0x1FF; // bits 0..8 stand for digits 1..9
+
+// Each placement records at most 22 changes (the cell, its mask, 20 peer masks) and at most 81 placements are live
+const int PROPAGATION_TRAIL_CAPACITY = 81 * (2 + SUDOKU_PEERS);
+
+struct PropagationState
+{
+    unsigned short cells[SUDOKU_CELLS];      // Placed digit, 0 if empty
+    unsigned short candidates[SUDOKU_CELLS]; // Candidate mask of empty cells, 0 once placed
+    SolverTrail<unsigned short, PROPAGATION_TRAIL_CAPACITY> trail;
+};
+
+// Places digit k in cell, then every naked single it creates; returns false on a contradiction or at the node limit
+bool placeAndPropagate(PropagationState &state, int cell, int k)
+{
+    unsigned char pending[SUDOKU_CELLS];
+    int pendingCount = 0;
+    for (;;)
+    {
+        const unsigned short bit = static_cast<unsigned short>(1 << (k - 1));
+        if (!(state.candidates[cell] & bit))
+            return false; // The digit was eliminated since the cell became a single
+        if (++solveNodeCount > solveNodeBudgetEnd)
+        {
+            solveGaveUp = true;
+            return false; // Node limit reached
+        }
+        state.trail.set(state.cells[cell], static_cast<unsigned short>(k));
+        state.trail.set(state.candidates[cell], 0);
+
+        const unsigned char *peers = SUDOKU_TABLES.peers[cell];
+        for (int i = 0; i < SUDOKU_PEERS; i++)
+        {
+            const int peer = peers[i];
+            const unsigned short mask = state.candidates[peer];
+            if (!(mask & bit))
+                continue;
+            const unsigned short remaining = mask & ~bit;
+            if (remaining == 0)
+                return false; // The peer has no candidate left
+            state.trail.set(state.candidates[peer], remaining);
+            if ((remaining & (remaining - 1)) == 0)
+                pending[pendingCount++] = static_cast<unsigned char>(peer); // Naked single
+        }
+
+        // Take the next single that is still empty (a cell can be queued twice)
+        do
+        {
+            if (pendingCount == 0)
+                return true;
+            cell = pending[--pendingCount];
+        } while (state.cells[cell] != 0);
+        k = lowestMaskBit(state.candidates[cell]) + 1;
+    }
+}
+
+bool searchPropagation(PropagationState &state)
+{
+    // Branch on the empty cell with the fewest candidates
+    int best = -1, bestCount = 10;
+    for (int cell = 0; cell < SUDOKU_CELLS && bestCount > 2; cell++)
+    {
+        if (state.cells[cell] != 0)
+            continue;
+        const int count = countMaskBits(state.candidates[cell]);
+        if (count < bestCount)
+        {
+            best = cell;
+            bestCount = count;
+        }
+    }
+    if (best == -1)
+        return true; // Every cell is placed
+
+    for (unsigned short mask = state.candidates[best]; mask; mask &= mask - 1)
+    {
+        const int mark = state.trail.mark();
+        if (placeAndPropagate(state, best, lowestMaskBit(mask) + 1) && searchPropagation(state))
+            return true;
+        state.trail.undo(mark); // Back to the state before this guess
+        if (solveGaveUp)
+            return false;
+    }
+    return false;
+}
+
+} // namespace
+
+bool solveBoardPropagation(int **BOARD)
+{
+    PropagationState state;
+    for (int cell = 0; cell < SUDOKU_CELLS; cell++)
+    {
+        state.cells[cell] = 0;
+        state.candidates[cell] = ALL_CANDIDATES;
+    }
+    for (int cell = 0; cell < SUDOKU_CELLS; cell++)
+    {
+        const int k = BOARD[SUDOKU_TABLES.row_of[cell]][SUDOKU_TABLES.col_of[cell]];
+        if (k != 0 && state.cells[cell] != k && !placeAndPropagate(state, cell, k))
+            return false; // Contradicting clues
+    }
+    if (!searchPropagation(state))
+        return false;
+
+    for (int cell = 0; cell < SUDOKU_CELLS; cell++)
+        BOARD[SUDOKU_TABLES.row_of[cell]][SUDOKU_TABLES.col_of[cell]] = state.cells[cell];
+    return true;
+}
+
+namespace
+{
+
+// Picks the unfilled cell with the fewest candidates, moves it behind the cells still to fill and returns it
+// with its candidates in `free`; returns -1 without changing the state if some unfilled cell has no candidate.
+int takeCompactCell(CompactSudokuState &state, unsigned short &free)
+{
+    const int remaining = state.empty_count;
+    int bestIndex = 0, bestCount = 10;
+    for (int i = 0; i < remaining; i++)
+    {
+        const unsigned short candidates = compactCandidates(state, state.empty[i]);
+        const int count = countMaskBits(candidates);
+        if (count < bestCount)
+        {
+            bestIndex = i;
+            bestCount = count;
+            free = candidates;
+            if (count <= 1)
+                break;
+        }
+    }
+    if (bestCount == 0)
+        return -1; // Dead cell
+
+    const int cell = state.empty[bestIndex];
+    state.empty[bestIndex] = state.empty[remaining - 1];
+    state.empty[remaining - 1] = static_cast<unsigned char>(cell);
+    state.empty_count--;
+    return cell;
+}
+
+} // namespace
+
+bool solveCompact(CompactSudokuState &state)
+{
+    if (state.empty_count == 0)
+        return true; // Every cell is filled
+
+    unsigned short free = 0;
+    const int cell = takeCompactCell(state, free);
+    if (cell < 0)
+        return false;
+
+    for (unsigned short mask = free; mask; mask &= mask - 1)
+    {
+        if (++solveNodeCount > solveNodeBudgetEnd)
+        {
+            solveGaveUp = true;
+            break; // Node limit reached
+        }
+        const unsigned short bit = mask & -mask;
+        toggleCompactDigit(state, cell, bit);
+        setCompactCell(state, cell, lowestMaskBit(bit) + 1);
+        if (solveCompact(state))
+            return true;
+        toggleCompactDigit(state, cell, bit);
+    }
+
+    setCompactCell(state, cell, 0); // Backtrack
+    state.empty_count++;
+    return false;
+}
+
+int countCompactSolutions(CompactSudokuState &state, const int &limit)
+{
+    if (state.empty_count == 0)
+        return 1;
+
+    unsigned short free = 0;
+    const int cell = takeCompactCell(state, free);
+    if (cell < 0)
+        return 0;
+
+    int found = 0;
+    for (unsigned short mask = free; mask && found < limit; mask &= mask - 1)
+    {
+        const unsigned short bit = mask & -mask;
+        toggleCompactDigit(state, cell, bit);
+        setCompactCell(state, cell, lowestMaskBit(bit) + 1);
+        found += countCompactSolutions(state, limit - found);
+        toggleCompactDigit(state, cell, bit);
+    }
+
+    setCompactCell(state, cell, 0);
+    state.empty_count++;
+    return found;
+}
+
+bool solveBoardCompact(int **BOARD)
+{
+    CompactSudokuState state;
+    if (!loadCompactState(BOARD, state) || !solveCompact(state))
+        return false;
+    storeCompactState(state, BOARD);
+    return true;
+}
+
 bool solve(int **board, const bool &efficient)
 {
     // Choose the solving method based on the 'efficient' flag
-    return (efficient) ? solveBoardEfficient(board) : solveBoard(board, 0, 0);
-}
\ No newline at end of file
+    return solve(board, efficient ? SOLVE_MRV : SOLVE_BACKTRACKING);
+}
+
+bool solve(int **board, const SolverStrategy &strategy)
+{
+    SUDOKU_TRACE_SCOPE("solve");
+    solveGaveUp = false;
+    solveNodeBudgetEnd = solveNodeLimit > 0 ? solveNodeCount + solveNodeLimit : LLONG_MAX;
+
+    bool solved = false;
+    switch (strategy)
+    {
+    case SOLVE_BACKTRACKING:
+        solved = solveBoard(board, 0, 0);
+        break;
+    case SOLVE_MRV:
+        solved = solveBoardEfficient(board);
+        break;
+    case SOLVE_PROPAGATION:
+        solved = solveBoardPropagation(board);
+        break;
+    case SOLVE_COMPACT:
+        solved = solveBoardCompact(board);
+        break;
+    }
+    solveNodeBudgetEnd = LLONG_MAX;
+    return solved;
+}
+
+const char* solverStrategyName(const bool& efficient)
+{
+    return solverStrategyName(efficient ? SOLVE_MRV : SOLVE_BACKTRACKING);
+}
+
+const char* solverStrategyName(const SolverStrategy& strategy)
+{
+    switch (strategy)
+    {
+    case SOLVE_MRV:
+        return "mrv-backtracking";
+    case SOLVE_PROPAGATION:
+        return "propagation";
+    case SOLVE_COMPACT:
+        return "compact-mrv";
+    default:
+        return "backtracking";
+    }
+}
+
+bool solverStrategyFromName(const string& name, SolverStrategy& strategy)
+{
+    for (int s = 0; s < SOLVER_STRATEGY_COUNT; s++)
+    {
+        if (name == solverStrategyName(static_cast<SolverStrategy>(s)))
+        {
+            strategy = static_cast<SolverStrategy>(s);
+            return true;
+        }
+    }
+    return false;
+}
+
+long long getSolveNodeCount()
+{
+    return solveNodeCount;
+}
+
+void setSolveNodeLimit(const long long& limit)
+{
+    solveNodeLimit = limit;
+}
+
+bool solveHitNodeLimit()
+{
+    return solveGaveUp;
+}
@@ -9,67 +9,115 @@
 #include <regex>
 #include <chrono>
 #include <iomanip>  // For formatted output
+#include <cstring>
+#include <climits>
+#include <atomic>
+#include <memory>
 
 #include "../include/generator.h"
 #include "../include/sudoku_io.h"
 #include "../include/utils.h"
 #include "../include/sudoku.h"
+#include "../include/sudoku_tables.h"
+#include "../include/async_io.h"
+#include "../include/file_manifest.h"
+#include "../include/checkpoint.h"
+#include "../include/alloc_stats.h"
+#include "../include/batch_stats.h"
+#include "../include/latency_histogram.h"
+#include "../include/trace.h"
+#include "../include/quarantine.h"
+#include "../include/puzzle_parser.h"
 
 using namespace std;
 using namespace std::chrono;
 
-void printBoard(int** BOARD, const int& r, const int& c, int k, const bool& color)
+// Larger folders only list their first this many files
+static const size_t MAX_LISTED_SUDOKUS = 100;
+
+// Row template shared by every renderer: 'x' marks a cell slot, everything else is copied verbatim.
+static const char ROW_TEMPLATE[] = "x x x | x x x | x x x \n";
+static const int ROW_TEMPLATE_LENGTH = sizeof(ROW_TEMPLATE) - 1;
+static const int CELL_SLOT[10] = {0, 2, 4, 8, 10, 12, 16, 18, 20, ROW_TEMPLATE_LENGTH};
+static const char BAND_SEPARATOR[] = ".....................\n";
+static const int BAND_SEPARATOR_LENGTH = sizeof(BAND_SEPARATOR) - 1;
+
+// Precomputed cell glyphs, indexed by cell value (0 = empty, drawn as '-'; INVALID_GLYPH for values outside 0-9).
+static const int INVALID_GLYPH = 10;
+struct GlyphTable {
+    char text[11][10];
+    int length[11];
+    GlyphTable(const char* prefix, const char* suffix) {
+        for (int v = 0; v <= INVALID_GLYPH; v++) {
+            string glyph = string(prefix) + (v == 0 ? '-' : v == INVALID_GLYPH ? '?' : char('0' + v)) + suffix;
+            length[v] = static_cast<int>(glyph.size());
+            memcpy(text[v], glyph.data(), glyph.size());
+        }
+    }
+};
+
+static const GlyphTable PLAIN_GLYPHS("", "");
+static const GlyphTable YELLOW_GLYPHS("\x1B[93m", "\x1B[0m");
+static const GlyphTable GREEN_GLYPHS("\x1B[32m", "\x1B[0m");
+static const GlyphTable RED_GLYPHS("\x1B[31m", "\x1B[0m");
+
+int renderBoard(int** BOARD, char* buffer, const int& r, const int& c, int k, const bool& color, const char& empty)
 {
     if(BOARD[r][c]>0) k = 0;
+    const bool highlightValid = k >= 1 && k <= 9 && isValid(BOARD, r, c, k);
 
+    char* out = buffer;
     for (int i = 0; i < 9; i++)
     {
         for (int j = 0; j < 9; j++)
         {
-            string board_piece;
-            if (BOARD[i][j] == 0) board_piece = color ? "\x1B[93m-\x1B[0m" : " "; // Yellow
-            else board_piece = to_string(BOARD[i][j]); // White
+            const GlyphTable* glyphs = &PLAIN_GLYPHS;
+            int value = BOARD[i][j];
             if ((i == r && j == c) && k != 0)
             {
-                if (isValid(BOARD, r, c, k))
-                    board_piece = color? "\x1B[32m" + to_string(k) + "\x1B[0m" : to_string(k); // Green
-                else
-                    board_piece = color? "\x1B[31m" + to_string(k) + "\x1B[0m" : to_string(k); // Red
+                value = k;
+                if (color) glyphs = highlightValid ? &GREEN_GLYPHS : &RED_GLYPHS;
+            }
+            if (value < 0 || value > 9) value = INVALID_GLYPH; // Files may hold any integer, never index past the table
+            if (value == 0 && !color)
+            {
+                *out++ = empty;
+            }
+            else
+            {
+                if (value == 0) glyphs = &YELLOW_GLYPHS;
+                memcpy(out, glyphs->text[value], glyphs->length[value]);
+                out += glyphs->length[value];
             }
-            cout << board_piece;
-            if (j == 2 || j == 5) cout << " | ";
-            else cout << " ";
+            const int gap = CELL_SLOT[j + 1] - CELL_SLOT[j] - 1;
+            memcpy(out, ROW_TEMPLATE + CELL_SLOT[j] + 1, gap);
+            out += gap;
         }
         if (i == 2 || i == 5)
         {
-            cout << endl;
-            for (int l = 0; l < 21; l++) cout << ".";
+            memcpy(out, BAND_SEPARATOR, BAND_SEPARATOR_LENGTH);
+            out += BAND_SEPARATOR_LENGTH;
         }
-        cout << endl;
     }
+    return static_cast<int>(out - buffer);
 }
 
-void boardToString(int** BOARD, string &content){
-    for(int i = 0; i < 9; i++){
-        for(int j = 0; j < 9; j++){
-            string board_piece;
-
-            if (BOARD[i][j] == 0) content += "-";
-            else content += to_string(BOARD[i][j]);
+void printBoard(int** BOARD, const int& r, const int& c, int k, const bool& color)
+{
+    char buffer[BOARD_TEXT_BUFFER_SIZE];
+    int length = renderBoard(BOARD, buffer, r, c, k, color, ' ');
+    cout.write(buffer, length);
+    cout.flush();
+}
 
-            if (j == 2 || j == 5)  content += " | ";
-            else content += " ";
-        }
-        if (i == 2 || i == 5)
-        {
-            content += "\n";
-            for (int l = 0; l < 21; l++) content += ".";
-        }
-        content += "\n";
-    }
+void boardToString(int** BOARD, string &content){
+    char buffer[BOARD_TEXT_BUFFER_SIZE];
+    int length = renderBoard(BOARD, buffer);
+    content.append(buffer, length);
 }
 
 bool writeSudokuToFile(int** BOARD, const string& filename) {
+    SUDOKU_TRACE_SCOPE("writeSudokuToFile");
     string content;
     boardToString(BOARD, content);
     ofstream outFile(filename); // Open file for writing
@@ -111,58 +159,99 @@ void fillBoard(const vector<int>& numbers, int **BOARD){
     }
 }
 
-int** readSudokuFromFile(const string& filename){
+int** readSudokuFromString(string sudoku){
+    SUDOKU_TRACE_SCOPE("readSudokuFromString");
     int** BOARD = new int*[9];
     vector<int> numbers;
 
-    ifstream file(filename);
-    string sudoku = string(istreambuf_iterator<char>(file), istreambuf_iterator<char>());
-
     replaceCharacter(sudoku, '-', '0');
     extractNumbers(sudoku, numbers);
     fillBoard(numbers, BOARD);
     return BOARD;
 }
 
+int** readSudokuFromFile(const string& filename){
+    SUDOKU_TRACE_SCOPE("readSudokuFromFile");
+    ifstream file(filename);
+    string sudoku = string(istreambuf_iterator<char>(file), istreambuf_iterator<char>());
+    return readSudokuFromString(sudoku);
+}
+
 bool checkIfSolutionIsValid(int** BOARD){
-    for(int r = 0; r < 9; r++) {
-        for(int c = 0; c < 9; c++) {
-            int k = BOARD[r][c];
-            BOARD[r][c] = 0;
-            if(!isValid(BOARD, r, c, k)){
-                BOARD[r][c] = k;
+    SUDOKU_TRACE_SCOPE("checkIfSolutionIsValid");
+    // Every row, column and box must hold each digit 1-9 exactly once
+    for(int u = 0; u < SUDOKU_UNITS; u++) {
+        unsigned int seen = 0;
+        for(int i = 0; i < 9; i++) {
+            const int cell = SUDOKU_TABLES.unit_cells[u][i];
+            const int k = BOARD[SUDOKU_TABLES.row_of[cell]][SUDOKU_TABLES.col_of[cell]];
+            if(k < 1 || k > 9 || (seen & (1u << k))){
                 // cout << "!!!!!!!!!!!!!!!! TEST FAILED !!!!!!!!!!!!!!!!" << endl;
                 return false;
             }
-            BOARD[r][c] = k;
+            seen |= 1u << k;
         }
     }
     // cout << "--------------- TEST PASSED ---------------" << endl;
     return true;
 }
 
-vector<string> getAllSudokuInFolder(const string& folderPath){
+vector<string> getAllSudokuInFolder(const string& folderPath, const string& manifestPath){
     vector<std::string> sudokus;
-    for (const auto& entry : filesystem::directory_iterator(folderPath)) {
-        if (filesystem::is_regular_file(entry)) {
-            sudokus.push_back(entry.path().string());
-        }
+    for (ManifestEntry& entry : loadSudokuManifest(folderPath, manifestPath)) {
+        sudokus.push_back(move(entry.path));
     }
+
     cout << sudokus.size() << " Sudoku Puzzle found @ " << folderPath << endl;
     cout << setfill('-') << setw(55)<< "" << setfill(' ') <<endl;
     cout << setw(5) << "Index" << setw(50) << "File Name" << endl;
     cout << setfill('-') << setw(55)<< "" << setfill(' ') <<endl;
-    for(int i = 0; i < sudokus.size(); i++)
+    const size_t listed = min(sudokus.size(), MAX_LISTED_SUDOKUS);
+    for(size_t i = 0; i < listed; i++)
         cout << setw(5) << i << setw(50) << sudokus[i] << endl;
+    if (listed < sudokus.size())
+        cout << setw(5) << "..." << setw(50) << to_string(sudokus.size() - listed) + " more" << endl;
     cout << setfill('-') << setw(55)<< "" << setfill(' ') <<endl;
     return sudokus;
 }
 
-void createAndSaveNPuzzles(const int& num_puzzles, const int& complexity_empty_boxes, const string& destination, const string& prefix){
+// Puzzle of a batch: a minimal one, or one with `complexity_empty_boxes` empty cells and a unique solution or
+// not, as selected by the options.
+static int** generateBatchBoard(const int& complexity_empty_boxes, const BatchOptions& options){
+    if(options.minimal_puzzles) return generateMinimalBoard(options.clue_symmetry, options.removal_order);
+    if(options.unique_puzzles) return generateUniqueBoard(complexity_empty_boxes, options.clue_symmetry, options.removal_order);
+    return generateBoard(complexity_empty_boxes);
+}
+
+// Asynchronous variant of createAndSaveNPuzzles: every write is queued on the backend.
+static void createAndSaveNPuzzlesAsync(const int& num_puzzles, const int& complexity_empty_boxes, const string& destination, const string& prefix, const BatchOptions& options){
+    FileIOBackend& io = *options.io;
+    atomic<int> total_success(0);
+    for(int i=0; i < num_puzzles; i++){
+        int** BOARD = generateBatchBoard(complexity_empty_boxes, options);
+        string content;
+        boardToString(BOARD, content);
+        deallocateBoard(BOARD);
+        string filename = getFileName(i, destination, prefix);
+        createParentFolders(filename);
+        io.submitWrite(filename, move(content), [&total_success](bool ok){
+            if(ok) total_success++;
+        });
+    }
+    io.drain();
+    cout << total_success << " files written out of " << num_puzzles << " (" << io.name() << ")" << endl;
+}
+
+void createAndSaveNPuzzles(const int& num_puzzles, const int& complexity_empty_boxes, const string& destination, const string& prefix, const BatchOptions& options){
+    if(options.io){
+        createAndSaveNPuzzlesAsync(num_puzzles, complexity_empty_boxes, destination, prefix, options);
+        return;
+    }
     int total_success = 0;
     for(int i=0; i < num_puzzles; i++){
-        int** BOARD = generateBoard(complexity_empty_boxes);
+        int** BOARD = generateBatchBoard(complexity_empty_boxes, options);
         string filename = getFileName(i, destination, prefix);
+        createParentFolders(filename);
         if(writeSudokuToFile(BOARD, filename)){
             total_success++;
             cout << "Successfully written(" << filename << ") "<< total_success << "of " << num_puzzles << endl;
@@ -190,29 +279,189 @@ void displayProgressBar(int current, int total, int barWidth = 50) {
     cout.flush();
 }
 
-void solveAndSaveNPuzzles(const int &num_puzzles, const string& source, const string& destination, const string& prefix){
+// Index of the i-th puzzle: taken from its file name so solution numbers match puzzle numbers.
+static int puzzleIndex(const vector<string>& path_to_sudokus, const size_t& i){
+    long long index = extractFileIndex(path_to_sudokus[i]);
+    return index >= 0 && index <= INT_MAX ? static_cast<int>(index) : static_cast<int>(i);
+}
+
+// Adds the heap traffic of the calling thread since `before` to `stage`.
+static void addAllocationsSince(AllocationCounters& stage, const AllocationCounters& before){
+    const AllocationCounters used = threadAllocationCounters() - before;
+    stage.allocations += used.allocations;
+    stage.deallocations += used.deallocations;
+    stage.bytes += used.bytes;
+}
+
+// Solves one batch puzzle with the basic solver, records its latency and quarantines it when it is too slow.
+static bool solveBatchPuzzle(int** sudoku, const string& source, const BatchOptions& options, BatchStats& stats){
+    const bool capture = !options.quarantine_path.empty();
+    char puzzle[PUZZLE_LINE_LENGTH];
+    if(capture) formatPuzzleLine(sudoku, puzzle);
+
+    const long long nodes_before = getSolveNodeCount();
+    const AllocationCounters allocations_before = threadAllocationCounters();
+    auto start = steady_clock::now();
+    bool solved = solve(sudoku) && checkIfSolutionIsValid(sudoku);
+    const double seconds = duration<double>(steady_clock::now() - start).count();
+    addAllocationsSince(stats.solve_allocations, allocations_before);
+    recordSolveLatency(stats, seconds);
+
+    const long long nodes = getSolveNodeCount() - nodes_before;
+    if(capture && exceedsQuarantineThresholds(seconds, nodes, options.quarantine_seconds, options.quarantine_nodes)){
+        QuarantineRecord record;
+        record.puzzle.assign(puzzle, PUZZLE_LINE_LENGTH);
+        record.strategy = solverStrategyName(false);
+        record.seconds = seconds;
+        record.nodes = nodes;
+        record.solved = solved;
+        record.source = source;
+        if(appendQuarantineRecord(options.quarantine_path, record)) stats.quarantined++;
+    }
+    return solved;
+}
+
+// Asynchronous variant of solveAndSaveNPuzzles: reads window w+1 while window w is solved and written.
+static void solveAndSaveNPuzzlesAsync(const int &num_puzzles, const vector<string>& path_to_sudokus, const string& destination, const string& prefix, const BatchOptions& options, BatchCheckpoint* checkpoint, BatchStats& stats){
+    FileIOBackend& io = *options.io;
+    atomic<int> total_success_write(0);
+    int total_success_solve = 0;
+    const size_t total = path_to_sudokus.size();
+    vector<string> contents[2] = {vector<string>(ASYNC_IO_WINDOW), vector<string>(ASYNC_IO_WINDOW)};
+    vector<char> loaded[2] = {vector<char>(ASYNC_IO_WINDOW, 0), vector<char>(ASYNC_IO_WINDOW, 0)};
+
+    auto submitReads = [&](const size_t& begin, const int& buffer){
+        for(size_t j = 0; j < ASYNC_IO_WINDOW && begin + j < total; j++){
+            string* content = &contents[buffer][j];
+            char* ok = &loaded[buffer][j];
+            *ok = 0;
+            if(checkpoint && checkpoint->isDone(puzzleIndex(path_to_sudokus, begin + j))){
+                stats.skipped++;
+                continue;
+            }
+            io.submitRead(path_to_sudokus[begin + j], [content, ok](bool success, string& data){
+                *ok = success;
+                if(success) content->swap(data);
+            });
+        }
+    };
+
+    submitReads(0, 0);
+    io.drain();
+    for(size_t begin = 0; begin < total; begin += ASYNC_IO_WINDOW){
+        const int current = static_cast<int>((begin / ASYNC_IO_WINDOW) % 2);
+        if(begin + ASYNC_IO_WINDOW < total) submitReads(begin + ASYNC_IO_WINDOW, 1 - current);
+
+        for(size_t j = 0; j < ASYNC_IO_WINDOW && begin + j < total; j++){
+            if(!loaded[current][j]) continue;
+            stats.loaded++;
+            AllocationCounters allocations_before = threadAllocationCounters();
+            int** sudoku = readSudokuFromString(contents[current][j]);
+            addAllocationsSince(stats.parse_allocations, allocations_before);
+            if(solveBatchPuzzle(sudoku, path_to_sudokus[begin + j], options, stats)){
+                total_success_solve++;
+                // The I/O threads' own allocations are not counted, only formatting and submission
+                allocations_before = threadAllocationCounters();
+                string content;
+                boardToString(sudoku, content);
+                const int index = puzzleIndex(path_to_sudokus, begin + j);
+                string filename = getFileName(index, destination, prefix);
+                createParentFolders(filename);
+                io.submitWrite(filename, move(content), [&total_success_write, checkpoint, index](bool ok){
+                    if(!ok) return;
+                    total_success_write++;
+                    if(checkpoint) checkpoint->markDone(index);
+                });
+                addAllocationsSince(stats.write_allocations, allocations_before);
+            }
+            deallocateBoard(sudoku);
+        }
+        displayProgressBar(static_cast<int>(min(begin + ASYNC_IO_WINDOW, total)), static_cast<int>(total));
+        io.drain();
+    }
+    cout << endl;
+    stats.solved = total_success_solve;
+    stats.written = total_success_write;
+    cout << "Puzzle Solved(over total): " << total_success_solve << "/" << num_puzzles << " | ";
+    cout << "Puzzle Solved Written(over total): " << total_success_write << "/" << num_puzzles << " (" << io.name() << ")" << endl;
+}
+
+void solveAndSaveNPuzzles(const int &num_puzzles, const string& source, const string& destination, const string& prefix, const BatchOptions& options){
+    if(options.shard_count < 1 || options.shard_index < 0 || options.shard_index >= options.shard_count){
+        cerr << "Invalid shard " << options.shard_index << "/" << options.shard_count << ", expected 0 <= index < count" << endl;
+        return;
+    }
     int total_success_solve = 0;
     int total_success_write = 0;
-    vector<string> path_to_sudokus = getAllSudokuInFolder(source);
+    vector<string> path_to_sudokus = getAllSudokuInFolder(source, options.manifest_path);
+    BatchStats stats;
+    auto run_start = steady_clock::now();
+
+    if(options.shard_count > 1){
+        // Keep only this shard's contiguous range of the sorted puzzles
+        const size_t total = path_to_sudokus.size();
+        const size_t first = total * options.shard_index / options.shard_count;
+        const size_t last = total * (options.shard_index + 1) / options.shard_count;
+        path_to_sudokus = vector<string>(path_to_sudokus.begin() + first, path_to_sudokus.begin() + last);
+        cout << "Shard " << options.shard_index << "/" << options.shard_count << ": puzzles " << first << " to " << last << endl;
+    }
+
+    unique_ptr<BatchCheckpoint> checkpoint;
+    if(!options.checkpoint_path.empty()){
+        int max_index = -1;
+        for(size_t i = 0; i < path_to_sudokus.size(); i++) max_index = max(max_index, puzzleIndex(path_to_sudokus, i));
+        checkpoint.reset(new BatchCheckpoint(options.checkpoint_path, max_index + 1, options.checkpoint_interval));
+        if(options.resume && checkpoint->load()){
+            cout << "Resuming: " << checkpoint->completed() << " puzzles already solved" << endl;
+        } else if(options.resume && filesystem::exists(options.checkpoint_path)){
+            // Keep the unreadable file for inspection rather than replacing it with this run's progress
+            cerr << "Cannot read checkpoint " << options.checkpoint_path << ", solving every puzzle without checkpointing" << endl;
+            checkpoint.reset();
+        }
+    }
+
+    if(options.io){
+        solveAndSaveNPuzzlesAsync(num_puzzles, path_to_sudokus, destination, prefix, options, checkpoint.get(), stats);
+        if(checkpoint) checkpoint->save();
+        stats.wall_seconds = duration<double>(steady_clock::now() - run_start).count();
+        if(options.stats) *options.stats = stats;
+        return;
+    }
 
     cout << "Number of loaded puzzles:" << path_to_sudokus.size() << "/" << num_puzzles << endl;
     for(int i = 0; i < path_to_sudokus.size(); i++){
+        if(checkpoint && checkpoint->isDone(puzzleIndex(path_to_sudokus, i))){
+            stats.skipped++;
+            continue;
+        }
+        AllocationCounters allocations_before = threadAllocationCounters();
         int** sudoku = readSudokuFromFile(path_to_sudokus[i]);
-        if(solve(sudoku)){
-            if(checkIfSolutionIsValid(sudoku)){
-                total_success_solve++;
-                string filename = getFileName(i, destination, prefix);
-                cout << "Puzzle Solved(over available): " << total_success_solve << "/" << path_to_sudokus.size() << " | ";
-                cout << "Puzzle Solved(over total): " << total_success_solve << "/" << num_puzzles << endl;
-                if(writeSudokuToFile(sudoku, filename)){
-                    total_success_write++;
-                }
-                cout << "Puzzle Solved Written(over available): " << total_success_write << "/" << path_to_sudokus.size() << " | ";
-                cout << "Puzzle Solved Written(over total): " << total_success_write << "/" << num_puzzles << endl;
+        addAllocationsSince(stats.parse_allocations, allocations_before);
+        stats.loaded++;
+        bool solved = solveBatchPuzzle(sudoku, path_to_sudokus[i], options, stats);
+        if(solved){
+            total_success_solve++;
+            allocations_before = threadAllocationCounters();
+            string filename = getFileName(puzzleIndex(path_to_sudokus, i), destination, prefix);
+            createParentFolders(filename);
+            cout << "Puzzle Solved(over available): " << total_success_solve << "/" << path_to_sudokus.size() << " | ";
+            cout << "Puzzle Solved(over total): " << total_success_solve << "/" << num_puzzles << endl;
+            const bool written = writeSudokuToFile(sudoku, filename);
+            addAllocationsSince(stats.write_allocations, allocations_before);
+            if(written){
+                total_success_write++;
+                if(checkpoint) checkpoint->markDone(puzzleIndex(path_to_sudokus, i));
             }
+            cout << "Puzzle Solved Written(over available): " << total_success_write << "/" << path_to_sudokus.size() << " | ";
+            cout << "Puzzle Solved Written(over total): " << total_success_write << "/" << num_puzzles << endl;
         }
         deallocateBoard(sudoku);
     }
+    if(checkpoint) checkpoint->save();
+    stats.solved = total_success_solve;
+    stats.written = total_success_write;
+    stats.wall_seconds = duration<double>(steady_clock::now() - run_start).count();
+    if(options.stats) *options.stats = stats;
 }
 
 
@@ -239,6 +488,8 @@ int** deepCopyBoard(int** original) {
 void compareSudokuSolvers(const int& experiment_size, const int& empty_boxes) {
     double totalTimeSolveBoard = 0.0;
     double totalTimeEfficientSolveBoard = 0.0;
+    LatencyHistogram latencySolveBoard;
+    LatencyHistogram latencyEfficientSolveBoard;
 
     int validSolutionsSolveBoard = 0;
     int validSolutionsEfficientSolveBoard = 0;
@@ -265,6 +516,7 @@ void compareSudokuSolvers(const int& experiment_size, const int& empty_boxes) {
 
         double elapsedEfficient = duration<double>(endEfficient - startEfficient).count();
         totalTimeEfficientSolveBoard += elapsedEfficient;
+        latencyEfficientSolveBoard.record(duration_cast<nanoseconds>(endEfficient - startEfficient).count());
 
         // Validate solution
         if (solved && checkIfSolutionIsValid(board1)) {
@@ -281,6 +533,7 @@ void compareSudokuSolvers(const int& experiment_size, const int& empty_boxes) {
 
         double elapsedSolve = duration<double>(endSolve - startSolve).count();
         totalTimeSolveBoard += elapsedSolve;
+        latencySolveBoard.record(duration_cast<nanoseconds>(endSolve - startSolve).count());
 
         // Validate solution
         if (solved && checkIfSolutionIsValid(board2)) {
@@ -304,12 +557,14 @@ void compareSudokuSolvers(const int& experiment_size, const int& empty_boxes) {
 
     cout << "solveBoard average time: " << fixed << setprecision(4)
          << 1000 * (totalTimeSolveBoard / experiment_size) << " milliseconds" << endl;
+    cout << "solveBoard latency: " << latencySolveBoard.summary() << endl;
     cout << "solveBoard valid solutions: " << validSolutionsSolveBoard << "/" << experiment_size << endl;
 
     cout << "-------------------------------------------------------------" << endl;
 
     cout << "efficientSolveBoard average time: " << fixed << setprecision(4)
          << 1000 * (totalTimeEfficientSolveBoard / experiment_size) << " milliseconds" << endl;
+    cout << "efficientSolveBoard latency: " << latencyEfficientSolveBoard.summary() << endl;
     cout << "efficientSolveBoard valid solutions: " << validSolutionsEfficientSolveBoard << "/" << experiment_size << endl;
 
     cout << "===========================================================================" << endl;
@@ -0,0 +1,128 @@
+/**
+ * @file trace.cpp
+ * @brief Implementation of per-thread trace ring buffers and the Chrome trace export.
+ *
+ * Each thread registers one ring buffer the first time it records an event.
+ * Buffers are never freed, so events of threads that already exited are still
+ * exported. Detailed function descriptions are provided in the corresponding
+ * header file.
+ */
+
+#include "../include/trace.h"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+using namespace std;
+using namespace std::chrono;
+
+namespace {
+
+struct TraceEvent {
+    const char* name;
+    long long start_ns;
+    long long end_ns;
+};
+
+struct ThreadTrace {
+    int tid = 0;
+    string name;
+    unique_ptr<TraceEvent[]> events{new TraceEvent[TRACE_RING_CAPACITY]};
+    atomic<unsigned long long> recorded{0}; // Total events ever recorded; the ring keeps the last TRACE_RING_CAPACITY
+};
+
+mutex registryLock;
+vector<unique_ptr<ThreadTrace>> registry;
+const steady_clock::time_point traceEpoch = steady_clock::now();
+
+ThreadTrace& threadTrace() {
+    thread_local ThreadTrace* current = nullptr;
+    if (!current) {
+        lock_guard<mutex> guard(registryLock);
+        registry.emplace_back(new ThreadTrace());
+        current = registry.back().get();
+        current->tid = static_cast<int>(registry.size());
+    }
+    return *current;
+}
+
+void writeJsonString(ostream& out, const string& text) {
+    out << '"';
+    for (char ch : text) {
+        if (ch == '"' || ch == '\\') out << '\\' << ch;
+        else if (static_cast<unsigned char>(ch) < 0x20) out << ' ';
+        else out << ch;
+    }
+    out << '"';
+}
+
+void writeMicroseconds(ostream& out, const long long& nanoseconds) {
+    char buffer[32];
+    snprintf(buffer, sizeof(buffer), "%lld.%03lld", nanoseconds / 1000, nanoseconds % 1000);
+    out << buffer;
+}
+
+} // namespace
+
+bool traceCompiledIn() {
+#ifdef SUDOKU_ENABLE_TRACE
+    return true;
+#else
+    return false;
+#endif
+}
+
+void setTraceThreadName(const string& name) {
+    if (!traceCompiledIn()) return; // Avoid allocating a ring buffer that will never be filled
+    ThreadTrace& trace = threadTrace();
+    lock_guard<mutex> guard(registryLock);
+    trace.name = name;
+}
+
+long long traceNow() {
+    return duration_cast<nanoseconds>(steady_clock::now() - traceEpoch).count();
+}
+
+void recordTraceEvent(const char* name, const long long& start_ns, const long long& end_ns) {
+    ThreadTrace& trace = threadTrace();
+    const unsigned long long slot = trace.recorded.load(memory_order_relaxed);
+    trace.events[slot % TRACE_RING_CAPACITY] = {name, start_ns, end_ns};
+    trace.recorded.store(slot + 1, memory_order_release);
+}
+
+bool writeChromeTrace(const string& filename) {
+    ofstream out(filename, ios::trunc);
+    if (!out.is_open()) return false;
+
+    lock_guard<mutex> guard(registryLock);
+    out << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n";
+    bool first = true;
+    for (const unique_ptr<ThreadTrace>& trace : registry) {
+        if (!trace->name.empty()) {
+            out << (first ? "" : ",\n") << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << trace->tid
+                << ",\"args\":{\"name\":";
+            writeJsonString(out, trace->name);
+            out << "}}";
+            first = false;
+        }
+        const unsigned long long recorded = trace->recorded.load(memory_order_acquire);
+        const unsigned long long begin = recorded > TRACE_RING_CAPACITY ? recorded - TRACE_RING_CAPACITY : 0;
+        for (unsigned long long i = begin; i < recorded; i++) {
+            const TraceEvent& event = trace->events[i % TRACE_RING_CAPACITY];
+            out << (first ? "" : ",\n") << "{\"name\":";
+            writeJsonString(out, event.name);
+            out << ",\"cat\":\"sudoku\",\"ph\":\"X\",\"pid\":1,\"tid\":" << trace->tid << ",\"ts\":";
+            writeMicroseconds(out, event.start_ns);
+            out << ",\"dur\":";
+            writeMicroseconds(out, event.end_ns - event.start_ns);
+            out << "}";
+            first = false;
+        }
+    }
+    out << "\n]}\n";
+    return static_cast<bool>(out);
+}
@@ -4,6 +4,9 @@
 #include <iostream>
 #include <string>
 #include <filesystem>
+#include <mutex>
+#include <unordered_set>
+#include "../include/utils.h"
 using namespace std;
 
 void deallocateBoard(int** BOARD, const int& rows) {
@@ -34,9 +37,52 @@ void initDataFolder(){
     createFolder("data/solutions/");
 }
 
+static FileNameLayout FILE_NAME_LAYOUT;
+
+FileNameLayout shardedFileNameLayout(){
+    FileNameLayout layout;
+    layout.index_width = 8;
+    layout.shard_levels = 2;
+    layout.shard_width = 2;
+    return layout;
+}
+
+void setFileNameLayout(const FileNameLayout& layout){
+    FILE_NAME_LAYOUT = layout;
+}
+
+const FileNameLayout& getFileNameLayout(){
+    return FILE_NAME_LAYOUT;
+}
+
+bool createParentFolders(const string& filename){
+    static mutex lock;
+    static unordered_set<string> created;
+
+    const filesystem::path parent = filesystem::path(filename).parent_path();
+    if (parent.empty()) return true;
+    const string key = parent.string();
+    lock_guard<mutex> guard(lock);
+    if (created.count(key)) return true;
+    error_code error;
+    filesystem::create_directories(parent, error);
+    if (error && !filesystem::is_directory(parent)) return false;
+    created.insert(key);
+    return true;
+}
+
 string getFileName(const int& index, const string& destination, const string& prefix){
+    const FileNameLayout& layout = FILE_NAME_LAYOUT;
     string index_str = to_string(index);
-    string index_fill = string(4 - index_str.length(), '0');
-    string filename = destination + index_fill + index_str + prefix + ".txt";
+    if (index_str.length() < static_cast<size_t>(layout.index_width))
+        index_str.insert(0, layout.index_width - index_str.length(), '0');
+
+    string filename = destination;
+    for (int level = 0; level < layout.shard_levels; level++) {
+        size_t start = static_cast<size_t>(level * layout.shard_width);
+        if (start + layout.shard_width > index_str.length()) break;
+        filename += index_str.substr(start, layout.shard_width) + "/";
+    }
+    filename += index_str + prefix + ".txt";
     return filename;
 }
\ No newline at end of file